@@ -0,0 +1,120 @@
+// Compare the matrix-free diffusion and mass operators with the assembled ones,
+// i.e. the results and timings of their action and diagonal
+
+#include <sfem/sfem.hpp>
+#include <argparse.hpp>
+#include <chrono>
+#include <cmath>
+
+using namespace sfem;
+
+/// @brief Time a number of repetitions of a function (including one untimed warm-up call)
+/// @return Time per repetition (seconds), i.e. the maximum over all processes
+template <typename Func>
+static real_t time_per_call(int n_iter, Func &&func)
+{
+    func();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_iter; i++)
+    {
+        func();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const real_t seconds = std::chrono::duration<real_t>(stop - start).count() / n_iter;
+    return mpi::reduce(seconds, mpi::ReduceOperation::max);
+}
+
+/// @brief Get the maximum difference of the owned values of two vectors,
+/// relative to the maximum absolute value of the first
+static real_t max_rel_diff(const la::Vector &a, const la::Vector &b)
+{
+    real_t max_diff = 0.0;
+    real_t max_abs = 0.0;
+    for (int i = 0; i < a.n_owned(); i++)
+    {
+        max_diff = std::max(max_diff, std::abs(a(i, 0) - b(i, 0)));
+        max_abs = std::max(max_abs, std::abs(a(i, 0)));
+    }
+    max_diff = mpi::reduce(max_diff, mpi::ReduceOperation::max);
+    max_abs = mpi::reduce(max_abs, mpi::ReduceOperation::max);
+    return max_abs > 0.0 ? max_diff / max_abs : max_diff;
+}
+
+/// @brief Compare a matrix-free operator with the matrix assembled by a kernel
+static void compare(const std::string &name,
+                    const fem::FEField &phi,
+                    const fem::FEKernel &kernel,
+                    const la::LinearOperator &A_mf,
+                    int n_iter)
+{
+    auto Axb = std::dynamic_pointer_cast<la::NativeLinearSystem>(fem::create_axb(phi));
+    fem::Equation eqn(phi, Axb);
+    eqn.add_kernel(kernel);
+    const real_t t_assemble = time_per_call(1, [&]()
+                                            { eqn.assemble(); });
+    const la::SparseMatrix &A = Axb->A();
+
+    // Multiply a smooth vector with both operators
+    const auto im = A.index_maps()[0];
+    la::Vector x(im, 1);
+    la::Vector y(im, 1);
+    la::Vector y_mf(im, 1);
+    for (int i = 0; i < im->n_owned(); i++)
+    {
+        x(i, 0) = std::sin(0.1 * i);
+    }
+
+    const real_t t_csr = time_per_call(n_iter, [&]()
+                                       { la::spmv_overlap(A, x, y); });
+    const real_t t_mf = time_per_call(n_iter, [&]()
+                                      { A_mf.apply(x, y_mf); });
+
+    la::Vector d(im, 1);
+    la::Vector d_mf(im, 1);
+    A.diagonal(d);
+    A_mf.diagonal(d_mf);
+
+    log_msg(std::format("{}: assembly {:.3e} s\n", name, t_assemble), true);
+    log_msg(std::format("  Assembled:   {:.3e} s/apply\n", t_csr), true);
+    log_msg(std::format("  Matrix-free: {:.3e} s/apply (speedup {:.2f})\n", t_mf, t_csr / t_mf), true);
+    log_msg(std::format("  Max. relative difference: {:.3e} (apply), {:.3e} (diagonal)\n",
+                        max_rel_diff(y, y_mf), max_rel_diff(d, d_mf)),
+            true);
+}
+
+int main(int argc, char *argv[])
+{
+    initialize(argc, argv, false, "matfree-bench");
+
+    argparse::ArgParser parser;
+    parser.add_argument(argparse::Argument("mesh-dir", true));
+    parser.add_argument(argparse::Argument("order", false).value<int>(2));
+    parser.add_argument(argparse::Argument("n-iter", false).value<int>(100));
+    parser.parse_args(argc, argv);
+
+    const int order = parser.get_argument("order")->value<int>();
+    const int n_iter = parser.get_argument("n-iter")->value<int>();
+    if (n_iter < 1)
+    {
+        SFEM_ERROR(std::format("Invalid number of iterations: {}\n", n_iter));
+    }
+
+    // Scalar field on a continuous Galerkin space
+    const auto mesh = io::read_mesh(parser.get_argument("mesh-dir")->value<std::string>());
+    const auto V = std::make_shared<fem::CGSpace>(mesh, order);
+    fem::FEField phi(V, {"phi"});
+    fem::ConstantField D("D", 1.0);
+    fem::ConstantField C("C", 1.0);
+
+    log_msg(std::format("DoF: {}, order: {}, processes: {}, threads: {}\n",
+                        V->index_map()->n_global(), order, mpi::n_procs(), omp::n_threads()),
+            true);
+
+    const fem::MatrixFreeDiffusion K_mf(phi, D);
+    compare("Diffusion", phi, fem::Diffusion(phi, D), K_mf, n_iter);
+
+    const fem::MatrixFreeMass M_mf(phi, C);
+    compare("Mass", phi, fem::MassND(phi, C), M_mf, n_iter);
+
+    return 0;
+}
\ No newline at end of file
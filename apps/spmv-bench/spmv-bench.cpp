@@ -0,0 +1,104 @@
+// Benchmark the sparse matrix-vector product of a finite volume Laplacian
+// in CSR and SELL-C-sigma format
+
+#include <sfem/sfem.hpp>
+#include <argparse.hpp>
+#include <chrono>
+#include <cmath>
+
+using namespace sfem;
+
+/// @brief Time a number of repetitions of a function (including one untimed warm-up call)
+/// @return Time per repetition (seconds), i.e. the maximum over all processes
+template <typename Func>
+static real_t time_per_call(int n_iter, Func &&func)
+{
+    func();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_iter; i++)
+    {
+        func();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const real_t seconds = std::chrono::duration<real_t>(stop - start).count() / n_iter;
+    return mpi::reduce(seconds, mpi::ReduceOperation::max);
+}
+
+int main(int argc, char *argv[])
+{
+    initialize(argc, argv, false, "spmv-bench");
+
+    argparse::ArgParser parser;
+    parser.add_argument(argparse::Argument("mesh-dir", true));
+    parser.add_argument(argparse::Argument("n-iter", false).value<int>(100));
+    parser.add_argument(argparse::Argument("sigma", false).value<int>(256));
+    parser.parse_args(argc, argv);
+
+    const int n_iter = parser.get_argument("n-iter")->value<int>();
+    const int sigma = parser.get_argument("sigma")->value<int>();
+    if (n_iter < 1)
+    {
+        SFEM_ERROR(std::format("Invalid number of iterations: {}\n", n_iter));
+    }
+
+    // Assemble the Laplacian of a scalar field
+    const auto mesh = io::read_mesh(parser.get_argument("mesh-dir")->value<std::string>(),
+                                    mesh::PartitionCriterion::shared_facet);
+    const auto V = std::make_shared<fvm::FVSpace>(mesh);
+    fvm::FVField phi(V, {"phi"});
+    fvm::ConstantField D("D", 1.0);
+
+    auto Axb = std::dynamic_pointer_cast<la::NativeLinearSystem>(fvm::create_axb(phi));
+    fvm::Equation eqn(phi, Axb);
+    eqn.add_kernel(fvm::Laplacian(phi, D));
+    eqn.assemble();
+    const la::SparseMatrix &A = Axb->A();
+
+    // Convert to SELL-C-sigma
+    std::unique_ptr<la::SellMatrix> A_sell;
+    const real_t t_convert = time_per_call(1, [&]()
+                                           { A_sell = std::make_unique<la::SellMatrix>(A, sigma); });
+
+    // Multiply a smooth vector in both formats
+    const auto im = A.index_maps()[0];
+    la::Vector x(im, 1);
+    la::Vector y_csr(im, 1);
+    la::Vector y_sell(im, 1);
+    for (int i = 0; i < im->n_owned(); i++)
+    {
+        x(i, 0) = std::sin(0.1 * i);
+    }
+
+    const real_t t_csr = time_per_call(n_iter, [&]()
+                                       { la::spmv_overlap(A, x, y_csr); });
+    const real_t t_sell = time_per_call(n_iter, [&]()
+                                        { la::spmv_overlap(*A_sell, x, y_sell); });
+
+    // Compare the results
+    real_t max_diff = 0.0;
+    for (int i = 0; i < im->n_owned(); i++)
+    {
+        max_diff = std::max(max_diff, std::abs(y_csr(i, 0) - y_sell(i, 0)));
+    }
+    max_diff = mpi::reduce(max_diff, mpi::ReduceOperation::max);
+
+    // Each non-zero entry costs one multiplication and one addition
+    const auto nnz = static_cast<real_t>(mpi::reduce(A.connectivity()->offset(im->n_owned()),
+                                                     mpi::ReduceOperation::sum));
+    auto gflops = [nnz](real_t seconds)
+    { return 2.0 * nnz / seconds * 1e-9; };
+
+    log_msg(std::format("Rows: {}, non-zeros: {}, processes: {}, threads: {}\n",
+                        im->n_global(), nnz, mpi::n_procs(), omp::n_threads()),
+            true);
+    log_msg(std::format("SELL-{}-{}: fill ratio {:.3f}, conversion {:.3e} s\n",
+                        la::SellMatrix::chunk_size, sigma, A_sell->fill_ratio(), t_convert),
+            true);
+    log_msg(std::format("CSR:  {:.3e} s/SpMV, {:.2f} GFlop/s\n", t_csr, gflops(t_csr)), true);
+    log_msg(std::format("SELL: {:.3e} s/SpMV, {:.2f} GFlop/s (speedup {:.2f})\n",
+                        t_sell, gflops(t_sell), t_csr / t_sell),
+            true);
+    log_msg(std::format("Max. difference: {:.3e}\n", max_diff), true);
+
+    return 0;
+}
\ No newline at end of file
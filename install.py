@@ -305,6 +305,10 @@ parser.add_argument('--mpi-cxx-compiler', type=str,
 parser.add_argument('--download-openmpi', action='store_true',
                     help="Download and build OpenMPI")
 
+# OpenMP
+parser.add_argument('--with-openmp', action='store_true',
+                    help="Enable shared-memory parallelism via OpenMP")
+
 # PETSc
 parser.add_argument('--petsc-dir', type=str,
                     metavar="", default=os.getenv("PETSC_DIR"),
@@ -461,6 +465,7 @@ cmake_args = {
     "CMAKE_CXX_COMPILER": args.cxx_compiler,
     "CMAKE_C_COMPILER": args.c_compiler,
     "WITH_MPI": "On" if args.with_mpi is True else "Off",
+    "WITH_OPENMP": "On" if args.with_openmp is True else "Off",
     "PETSC_DIR":  args.petsc_dir,
     "PETSC_ARCH": args.petsc_arch,
     "SLEPC_DIR": args.slepc_dir,
@@ -552,6 +557,7 @@ with open("summary.log", "w") as file:
     if args.with_apps:
         lines += f"Applications directory {get_applications_dir(args.install_dir)}\n"
     lines += f"MPI enabled: {args.with_mpi}\n"
+    lines += f"OpenMP enabled: {args.with_openmp}\n"
     lines += f"C compiler: {args.c_compiler}\n"
     lines += f"C++ compiler: {args.cxx_compiler}\n"
 
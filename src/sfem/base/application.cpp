@@ -1,5 +1,6 @@
 #include "application.hpp"
 #include <sfem/parallel/mpi.hpp>
+#include <sfem/parallel/omp.hpp>
 #include <sfem/la/petsc/petsc.hpp>
 #include <sfem/la/slepc/slepc.hpp>
 #include <iostream>
@@ -96,6 +97,16 @@ namespace sfem
         log_level_ = level;
     }
     //=============================================================================
+    void Application::set_n_threads(int n_threads)
+    {
+        omp::set_n_threads(n_threads);
+    }
+    //=============================================================================
+    int Application::n_threads() const
+    {
+        return omp::n_threads();
+    }
+    //=============================================================================
     Application &Application::instance(int argc, char *argv[],
                                        const std::string &name, bool write_log_file)
     {
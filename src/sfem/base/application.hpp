@@ -16,6 +16,12 @@ namespace sfem
 
         void set_option(const std::string &name, const std::string &value);
 
+        /// @brief Set the number of (OpenMP) threads used per process
+        void set_n_threads(int n_threads);
+
+        /// @brief Get the number of (OpenMP) threads used per process
+        int n_threads() const;
+
         void log_message(const std::string &msg, LogLevel level) const;
 
         /// @brief Get the application instance
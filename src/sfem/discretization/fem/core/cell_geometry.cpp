@@ -0,0 +1,259 @@
+#include "cell_geometry.hpp"
+#include <sfem/discretization/fem/core/fe_space.hpp>
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/parallel/omp.hpp>
+
+namespace sfem::fem
+{
+    //=============================================================================
+    /// @brief Invert the Jacobians of a batch of cells (SoA layout),
+    /// computing the determinants
+    /// @param nc Number of cells
+    static void invert_jacobians(int dim, int nc, const real_t *J, real_t *invJ, real_t *detJ)
+    {
+        // Entry (i, j) of the Jacobian of all cells
+        auto Jij = [&](int i, int j)
+        { return J + (i * dim + j) * nc; };
+        auto invJij = [&](int i, int j)
+        { return invJ + (i * dim + j) * nc; };
+
+        if (dim == 1)
+        {
+            const real_t *a = Jij(0, 0);
+            real_t *ia = invJij(0, 0);
+            SFEM_OMP(simd)
+            for (int c = 0; c < nc; c++)
+            {
+                detJ[c] = a[c];
+                ia[c] = 1.0 / a[c];
+            }
+        }
+        else if (dim == 2)
+        {
+            const real_t *a = Jij(0, 0), *b = Jij(0, 1);
+            const real_t *c_ = Jij(1, 0), *d = Jij(1, 1);
+            real_t *ia = invJij(0, 0), *ib = invJij(0, 1);
+            real_t *ic = invJij(1, 0), *id = invJij(1, 1);
+            SFEM_OMP(simd)
+            for (int c = 0; c < nc; c++)
+            {
+                const real_t det = a[c] * d[c] - b[c] * c_[c];
+                const real_t idet = 1.0 / det;
+                detJ[c] = det;
+                ia[c] = idet * d[c];
+                ib[c] = -idet * b[c];
+                ic[c] = -idet * c_[c];
+                id[c] = idet * a[c];
+            }
+        }
+        else
+        {
+            const real_t *m0 = Jij(0, 0), *m1 = Jij(0, 1), *m2 = Jij(0, 2);
+            const real_t *m3 = Jij(1, 0), *m4 = Jij(1, 1), *m5 = Jij(1, 2);
+            const real_t *m6 = Jij(2, 0), *m7 = Jij(2, 1), *m8 = Jij(2, 2);
+            real_t *i0 = invJij(0, 0), *i1 = invJij(0, 1), *i2 = invJij(0, 2);
+            real_t *i3 = invJij(1, 0), *i4 = invJij(1, 1), *i5 = invJij(1, 2);
+            real_t *i6 = invJij(2, 0), *i7 = invJij(2, 1), *i8 = invJij(2, 2);
+            SFEM_OMP(simd)
+            for (int c = 0; c < nc; c++)
+            {
+                const real_t c0 = m4[c] * m8[c] - m5[c] * m7[c];
+                const real_t c3 = m5[c] * m6[c] - m3[c] * m8[c];
+                const real_t c6 = m3[c] * m7[c] - m4[c] * m6[c];
+                const real_t det = m0[c] * c0 + m1[c] * c3 + m2[c] * c6;
+                const real_t idet = 1.0 / det;
+                detJ[c] = det;
+                i0[c] = idet * c0;
+                i1[c] = -idet * (m1[c] * m8[c] - m2[c] * m7[c]);
+                i2[c] = idet * (m1[c] * m5[c] - m2[c] * m4[c]);
+                i3[c] = idet * c3;
+                i4[c] = idet * (m0[c] * m8[c] - m2[c] * m6[c]);
+                i5[c] = -idet * (m0[c] * m5[c] - m2[c] * m3[c]);
+                i6[c] = idet * c6;
+                i7[c] = -idet * (m0[c] * m7[c] - m1[c] * m6[c]);
+                i8[c] = idet * (m0[c] * m4[c] - m1[c] * m3[c]);
+            }
+        }
+    }
+    //=============================================================================
+    void CellGeometry::compute(const FESpace &V, mesh::CellType cell_type, std::span<const int> cells)
+    {
+        element_ = V.element(cell_type).get();
+        const auto int_rule = element_->integration_rule();
+        const int n_nodes = element_->n_nodes();
+        n_points_ = int_rule->n_points();
+        dim_ = element_->dim();
+        if (dim_ < 1 or dim_ > 3)
+        {
+            SFEM_ERROR(std::format("Cannot evaluate the geometry of {} cells\n", mesh::cell_type_str(cell_type)));
+        }
+
+        cells_.assign(cells.begin(), cells.end());
+        const int nc = n_cells();
+
+        // Shape functions and their gradients at the integration points
+        N_.resize(n_points_ * n_nodes);
+        dNdxi_.resize(n_points_ * n_nodes * dim_);
+        for (int q = 0; q < n_points_; q++)
+        {
+            const auto N = element_->shape_table(q);
+            const auto dNdxi = element_->shape_grad_table(q);
+            std::copy(N.begin(), N.end(), N_.begin() + q * n_nodes);
+            std::copy(dNdxi.begin(), dNdxi.end(), dNdxi_.begin() + q * n_nodes * dim_);
+        }
+
+        // Gather the node coordinates
+        X_.resize(n_nodes * dim_ * nc);
+        for (int c = 0; c < nc; c++)
+        {
+            V.cell_dof_points(cells_[c], pts_);
+            for (int k = 0; k < n_nodes; k++)
+            {
+                for (int i = 0; i < dim_; i++)
+                {
+                    X_[(k * dim_ + i) * nc + c] = pts_[k][i];
+                }
+            }
+        }
+
+        // Natural-to-physical Jacobian: J(i, j) = sum_k X_k(i) * dN_k/dxi_j
+        const int n_entries = dim_ * dim_;
+        J_.assign(n_points_ * n_entries * nc, 0.0);
+        for (int q = 0; q < n_points_; q++)
+        {
+            for (int i = 0; i < dim_; i++)
+            {
+                for (int j = 0; j < dim_; j++)
+                {
+                    real_t *Jqij = J_.data() + (q * n_entries + i * dim_ + j) * nc;
+                    for (int k = 0; k < n_nodes; k++)
+                    {
+                        const real_t dNkj = dNdxi_[(q * n_nodes + k) * dim_ + j];
+                        const real_t *Xki = X_.data() + (k * dim_ + i) * nc;
+                        SFEM_OMP(simd)
+                        for (int c = 0; c < nc; c++)
+                        {
+                            Jqij[c] += dNkj * Xki[c];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Inverse Jacobian and determinant
+        invJ_.resize(n_points_ * n_entries * nc);
+        detJ_.resize(n_points_ * nc);
+        detJw_.resize(n_points_ * nc);
+        for (int q = 0; q < n_points_; q++)
+        {
+            invert_jacobians(dim_, nc,
+                             J_.data() + q * n_entries * nc,
+                             invJ_.data() + q * n_entries * nc,
+                             detJ_.data() + q * nc);
+
+            const real_t qwt = int_rule->weight(q);
+            const real_t *detJq = detJ_.data() + q * nc;
+            real_t *detJwq = detJw_.data() + q * nc;
+            bool negative = false;
+            SFEM_OMP(simd reduction(|| : negative))
+            for (int c = 0; c < nc; c++)
+            {
+                detJwq[c] = detJq[c] * qwt;
+                negative = negative or detJq[c] <= 0;
+            }
+
+            // Check for non-positive jacobian
+            if (negative)
+            {
+                /// @todo
+                SFEM_ERROR(std::format("Negative Jacobian"));
+            }
+        }
+    }
+    //=============================================================================
+    const FiniteElement &CellGeometry::element() const
+    {
+        return *element_;
+    }
+    //=============================================================================
+    std::span<const int> CellGeometry::cells() const
+    {
+        return cells_;
+    }
+    //=============================================================================
+    int CellGeometry::n_cells() const
+    {
+        return static_cast<int>(cells_.size());
+    }
+    //=============================================================================
+    int CellGeometry::n_points() const
+    {
+        return n_points_;
+    }
+    //=============================================================================
+    int CellGeometry::dim() const
+    {
+        return dim_;
+    }
+    //=============================================================================
+    std::span<const real_t> CellGeometry::shape(int qpt_idx) const
+    {
+        const int n_nodes = element_->n_nodes();
+        return {N_.data() + qpt_idx * n_nodes, static_cast<std::size_t>(n_nodes)};
+    }
+    //=============================================================================
+    std::span<const real_t> CellGeometry::shape_grad(int qpt_idx) const
+    {
+        const int n_nodes = element_->n_nodes();
+        return {dNdxi_.data() + qpt_idx * n_nodes * dim_, static_cast<std::size_t>(n_nodes * dim_)};
+    }
+    //=============================================================================
+    std::span<const real_t> CellGeometry::detJ(int qpt_idx) const
+    {
+        return {detJ_.data() + qpt_idx * n_cells(), static_cast<std::size_t>(n_cells())};
+    }
+    //=============================================================================
+    std::span<const real_t> CellGeometry::detJw(int qpt_idx) const
+    {
+        return {detJw_.data() + qpt_idx * n_cells(), static_cast<std::size_t>(n_cells())};
+    }
+    //=============================================================================
+    std::span<const real_t> CellGeometry::invJ(int qpt_idx, int i, int j) const
+    {
+        const int offset = ((qpt_idx * dim_ + i) * dim_ + j) * n_cells();
+        return {invJ_.data() + offset, static_cast<std::size_t>(n_cells())};
+    }
+    //=============================================================================
+    void CellGeometry::transform(int cell, int qpt_idx, FEData &data) const
+    {
+        const int n_nodes = element_->n_nodes();
+        const int nc = n_cells();
+        const int n_entries = dim_ * dim_;
+
+        data.reset(cells_[cell], n_nodes, dim_, dim_);
+        data.pt = element_->integration_rule()->point(qpt_idx);
+        data.int_rule = element_->integration_rule();
+        data.qpt_idx = qpt_idx;
+        data.detJ = detJ_[qpt_idx * nc + cell];
+
+        std::copy_n(N_.cbegin() + qpt_idx * n_nodes, n_nodes, data.N.values().begin());
+        std::copy_n(dNdxi_.cbegin() + qpt_idx * n_nodes * dim_, n_nodes * dim_,
+                    data.dNdxi.values().begin());
+
+        for (int i = 0; i < dim_; i++)
+        {
+            for (int j = 0; j < dim_; j++)
+            {
+                const int offset = (qpt_idx * n_entries + i * dim_ + j) * nc + cell;
+                data.dXdxi(i, j) = J_[offset];
+                data.dxidX(i, j) = invJ_[offset];
+            }
+        }
+
+        // Shape function gradient w.r.t physical coordinates
+        la::utils::matmult(n_nodes, dim_, dim_,
+                           data.dNdxi.values(),
+                           data.dxidX.values(),
+                           data.dNdX.values());
+    }
+}
\ No newline at end of file
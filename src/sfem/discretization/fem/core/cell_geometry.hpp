@@ -0,0 +1,101 @@
+#pragma once
+
+#include <sfem/discretization/fem/core/elements/fe.hpp>
+
+namespace sfem::fem
+{
+    // Forward declaration
+    class FESpace;
+
+    /// @brief Geometry of a batch of cells of the same type, evaluated at the points
+    /// of the element's integration rule, i.e. the Jacobian determinant (also scaled by
+    /// the quadrature weight) and the inverse Jacobian.
+    ///
+    /// Values are stored in structure-of-arrays layout, with the cell index running fastest,
+    /// so that the evaluation vectorizes across the cells of the batch. Storage is reused
+    /// between batches, thus each thread should use its own instance
+    /// @note Only cells whose physical dimension equals the element's dimension are supported
+    class CellGeometry
+    {
+    public:
+        /// @brief Evaluate the geometry for a batch of cells
+        /// @param V Finite element space
+        /// @param cell_type Type of all cells in the batch
+        /// @param cells Cell indices
+        void compute(const FESpace &V, mesh::CellType cell_type, std::span<const int> cells);
+
+        /// @brief Get the element of the cells
+        const FiniteElement &element() const;
+
+        /// @brief Get the cell indices
+        std::span<const int> cells() const;
+
+        /// @brief Get the number of cells
+        int n_cells() const;
+
+        /// @brief Get the number of integration points
+        int n_points() const;
+
+        /// @brief Get the (physical and reference) dimension
+        int dim() const;
+
+        /// @brief Get the shape functions at an integration point
+        std::span<const real_t> shape(int qpt_idx) const;
+
+        /// @brief Get the shape function gradients (natural) at an integration point,
+        /// i.e. a row-major (n_nodes x dim) array
+        std::span<const real_t> shape_grad(int qpt_idx) const;
+
+        /// @brief Get the Jacobian determinant of all cells at an integration point
+        std::span<const real_t> detJ(int qpt_idx) const;
+
+        /// @brief Get the Jacobian determinant times the quadrature weight
+        /// of all cells at an integration point
+        std::span<const real_t> detJw(int qpt_idx) const;
+
+        /// @brief Get an entry of the inverse Jacobian (dxi_i / dX_j)
+        /// of all cells at an integration point
+        std::span<const real_t> invJ(int qpt_idx, int i, int j) const;
+
+        /// @brief Fill the transform data of a cell at an integration point,
+        /// i.e. the equivalent of FiniteElement::transform without recomputing the geometry
+        /// @param cell Position of the cell in the batch
+        /// @param qpt_idx Integration point index
+        /// @param data Transform data
+        void transform(int cell, int qpt_idx, FEData &data) const;
+
+    private:
+        /// @brief Element
+        const FiniteElement *element_ = nullptr;
+
+        /// @brief Cell indices
+        std::vector<int> cells_;
+
+        /// @brief Number of integration points
+        int n_points_ = 0;
+
+        /// @brief Dimension
+        int dim_ = 0;
+
+        /// @brief Shape functions and their gradients (natural) at the integration points
+        std::vector<real_t> N_;
+        std::vector<real_t> dNdxi_;
+
+        /// @brief Element DoF points of a cell
+        std::vector<std::array<real_t, 3>> pts_;
+
+        /// @brief Element DoF point coordinates, for each node and direction
+        std::vector<real_t> X_;
+
+        /// @brief Jacobian, for each integration point and entry
+        std::vector<real_t> J_;
+
+        /// @brief Inverse Jacobian, for each integration point and entry
+        std::vector<real_t> invJ_;
+
+        /// @brief Jacobian determinant, without and with the quadrature weight,
+        /// for each integration point
+        std::vector<real_t> detJ_;
+        std::vector<real_t> detJw_;
+    };
+}
\ No newline at end of file
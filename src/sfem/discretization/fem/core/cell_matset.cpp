@@ -0,0 +1,45 @@
+#include "cell_matset.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+
+namespace sfem::fem
+{
+    //=============================================================================
+    CellMatSet::CellMatSet(la::MatSet matset)
+        : matset_(std::move(matset)),
+          mat_(nullptr),
+          V_(nullptr)
+    {
+    }
+    //=============================================================================
+    CellMatSet::CellMatSet(la::SparseMatrix &mat, const FESpace &V)
+        : matset_(la::create_matset(mat)),
+          mat_(&mat),
+          V_(&V)
+    {
+        if (mat.connectivity() != V.connectivity()[1])
+        {
+            SFEM_ERROR(std::format("Matrix sparsity does not correspond to {} space\n", V.name()));
+        }
+    }
+    //=============================================================================
+    void CellMatSet::operator()(std::span<const int> row_idxs,
+                                std::span<const int> col_idxs,
+                                std::span<const real_t> values) const
+    {
+        matset_(row_idxs, col_idxs, values);
+    }
+    //=============================================================================
+    void CellMatSet::operator()(int cell_idx,
+                                std::span<const int> cell_dof,
+                                std::span<const real_t> values) const
+    {
+        if (mat_ == nullptr)
+        {
+            matset_(cell_dof, cell_dof, values);
+            return;
+        }
+        mat_->add_values(V_->cell_csr_idxs(cell_idx),
+                         static_cast<int>(cell_dof.size()),
+                         values);
+    }
+}
\ No newline at end of file
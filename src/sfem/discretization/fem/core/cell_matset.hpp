@@ -0,0 +1,44 @@
+#pragma once
+
+#include <sfem/discretization/fem/core/fe_space.hpp>
+#include <sfem/la/native/setval_utils.hpp>
+
+namespace sfem::fem
+{
+    /// @brief Sets the values of a matrix for finite element kernels. Besides setting values
+    /// for given rows and columns (as a la::MatSet), it accepts the element matrix of a cell
+    /// along with the cell index. For a native matrix with the sparsity of a finite element
+    /// space, the element matrix is then added directly to its precomputed positions
+    /// (see FESpace::cell_csr_idxs), without searching the columns of each row
+    class CellMatSet
+    {
+    public:
+        /// @brief Create a CellMatSet which sets all values via a la::MatSet
+        CellMatSet(la::MatSet matset);
+
+        /// @brief Create a CellMatSet for a matrix with the sparsity of a finite element space
+        /// @note The matrix and the space are referenced, thus they must outlive the CellMatSet
+        CellMatSet(la::SparseMatrix &mat, const FESpace &V);
+
+        /// @brief Set the values for given rows and columns
+        void operator()(std::span<const int> row_idxs,
+                        std::span<const int> col_idxs,
+                        std::span<const real_t> values) const;
+
+        /// @brief Set the element matrix of a cell
+        /// @param cell_idx Cell index
+        /// @param cell_dof The DoF of the cell, i.e. FESpace::cell_dof(cell_idx)
+        /// @param values Element matrix (cell_dof rows and columns)
+        void operator()(int cell_idx,
+                        std::span<const int> cell_dof,
+                        std::span<const real_t> values) const;
+
+    private:
+        /// @brief Setter for all values, or for those not set via the cell-to-CSR map
+        la::MatSet matset_;
+
+        /// @brief Matrix and space of the cell-to-CSR map (nullptr if not used)
+        la::SparseMatrix *mat_;
+        const FESpace *V_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <sfem/mesh/cell.hpp>
+#include <type_traits>
+
+namespace sfem::fem
+{
+    /// @brief Invoke an element kernel specialized for a given cell type and order
+    /// @param cell_type Cell type
+    /// @param order Element order
+    /// @param kernel Callable accepting a std::integral_constant<int, NNodes> and a
+    /// std::integral_constant<int, Dim>, i.e. the number of nodes and the dimension of
+    /// the element. Specializations exist for the linear triangle, quadrilateral,
+    /// tetrahedron and hexahedron. For any other element NNodes and Dim are 0,
+    /// in which case the kernel should fall back to runtime-sized computations
+    template <typename Kernel>
+    decltype(auto) dispatch_element(mesh::CellType cell_type, int order, Kernel &&kernel)
+    {
+        if (order == 1)
+        {
+            switch (cell_type)
+            {
+            case mesh::CellType::triangle:
+                return kernel(std::integral_constant<int, 3>{}, std::integral_constant<int, 2>{});
+            case mesh::CellType::quadrilateral:
+                return kernel(std::integral_constant<int, 4>{}, std::integral_constant<int, 2>{});
+            case mesh::CellType::tetrahedron:
+                return kernel(std::integral_constant<int, 4>{}, std::integral_constant<int, 3>{});
+            case mesh::CellType::hexahedron:
+                return kernel(std::integral_constant<int, 8>{}, std::integral_constant<int, 3>{});
+            default:
+                break;
+            }
+        }
+        return kernel(std::integral_constant<int, 0>{}, std::integral_constant<int, 0>{});
+    }
+}
\ No newline at end of file
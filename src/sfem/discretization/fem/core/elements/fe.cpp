@@ -1,4 +1,6 @@
 #include "fe.hpp"
+#include "tensor_product.hpp"
+#include <sfem/parallel/omp.hpp>
 
 namespace sfem::fem
 {
@@ -40,12 +42,107 @@ namespace sfem::fem
         return mesh::cell_dim(cell_type_);
     }
     //=============================================================================
+    std::span<const real_t> FiniteElement::shape_table(int qpt_idx) const
+    {
+        tabulate();
+        SFEM_CHECK_INDEX(qpt_idx, integration_rule_->n_points());
+        const int n = n_nodes();
+        return {N_table_.data() + qpt_idx * n, static_cast<std::size_t>(n)};
+    }
+    //=============================================================================
+    std::span<const real_t> FiniteElement::shape_grad_table(int qpt_idx) const
+    {
+        tabulate();
+        SFEM_CHECK_INDEX(qpt_idx, integration_rule_->n_points());
+        const int n = n_nodes() * dim();
+        return {dNdxi_table_.data() + qpt_idx * n, static_cast<std::size_t>(n)};
+    }
+    //=============================================================================
+    const TensorProductBasis *FiniteElement::tensor_product_basis() const
+    {
+        // The 1D matrices depend on the number of integration points,
+        // which may change through the (mutable) integration rule
+        const int n_points = integration_rule_->n_points();
+        if (tp_n_points_.load(std::memory_order_acquire) != n_points)
+        {
+            std::lock_guard lock(tp_mutex_);
+            if (tp_n_points_.load(std::memory_order_relaxed) != n_points)
+            {
+                tp_basis_.reset();
+                if (TensorProductBasis::is_tensor_product(*this))
+                {
+                    tp_basis_ = std::make_shared<const TensorProductBasis>(*this);
+                }
+                tp_n_points_.store(n_points, std::memory_order_release);
+            }
+        }
+        return tp_basis_.get();
+    }
+    //=============================================================================
+    void FiniteElement::tabulate() const
+    {
+        // The tables depend on the number of integration points,
+        // which may change through the (mutable) integration rule
+        const int n_points = integration_rule_->n_points();
+        if (table_n_points_.load(std::memory_order_acquire) == n_points)
+        {
+            return;
+        }
+        std::lock_guard lock(table_mutex_);
+        if (table_n_points_.load(std::memory_order_relaxed) == n_points)
+        {
+            return;
+        }
+
+        const int n_nodes = this->n_nodes();
+        const int gdim = dim();
+        N_table_.resize(n_points * n_nodes);
+        dNdxi_table_.resize(n_points * n_nodes * gdim);
+
+        la::DenseMatrix N(n_nodes, 1);
+        la::DenseMatrix dNdxi(n_nodes, gdim);
+        for (int i = 0; i < n_points; i++)
+        {
+            const auto pt = integration_rule_->point(i);
+            eval_shape(pt, N);
+            std::copy(N.values().cbegin(), N.values().cend(), N_table_.begin() + i * n_nodes);
+
+            // Point elements have no shape function gradients
+            if (gdim > 0)
+            {
+                eval_shape_grad(pt, dNdxi);
+                std::copy(dNdxi.values().cbegin(), dNdxi.values().cend(),
+                          dNdxi_table_.begin() + i * n_nodes * gdim);
+            }
+        }
+
+        table_n_points_.store(n_points, std::memory_order_release);
+    }
+    //=============================================================================
+    FEData FiniteElement::transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
+                                    std::span<const std::array<real_t, 3>> elem_pts) const
+    {
+        FEData data(elem_idx, n_nodes(), pdim, dim());
+        transform(elem_idx, pdim, pt, elem_pts, data);
+        return data;
+    }
+    //=============================================================================
+    FEData FiniteElement::transform(int elem_idx, int pdim, int qpt_idx,
+                                    std::span<const std::array<real_t, 3>> elem_pts) const
+    {
+        FEData data(elem_idx, n_nodes(), pdim, dim());
+        transform(elem_idx, pdim, qpt_idx, elem_pts, data);
+        return data;
+    }
+    //=============================================================================
     FEData::FEData(int elem_idx_, int n_nodes_, int pdim_, int gdim_)
         : elem_idx(elem_idx_),
           n_nodes(n_nodes_),
           pdim(pdim_),
           gdim(gdim_),
           pt({}),
+          int_rule(nullptr),
+          qpt_idx(-1),
           detJ(0.0),
           dXdxi(pdim_, gdim_),
           dxidX(gdim_, pdim_),
@@ -54,4 +151,43 @@ namespace sfem::fem
           dNdX(n_nodes_, pdim_)
     {
     }
+    //=============================================================================
+    void FEData::reset(int elem_idx_, int n_nodes_, int pdim_, int gdim_)
+    {
+        elem_idx = elem_idx_;
+        n_nodes = n_nodes_;
+        pdim = pdim_;
+        gdim = gdim_;
+        pt = {};
+        int_rule = nullptr;
+        qpt_idx = -1;
+        detJ = 0.0;
+        dXdxi.resize(pdim_, gdim_);
+        dxidX.resize(gdim_, pdim_);
+        N.resize(n_nodes_, 1);
+        dNdxi.resize(n_nodes_, gdim_);
+        dNdX.resize(n_nodes_, pdim_);
+    }
+    //=============================================================================
+    ElementWorkspace::ElementWorkspace(int n_matrices)
+        : data(-1, 1, 1, 1)
+    {
+        matrices_.reserve(n_matrices);
+        for (int i = 0; i < n_matrices; i++)
+        {
+            matrices_.emplace_back(1, 1);
+        }
+    }
+    //=============================================================================
+    la::DenseMatrix &ElementWorkspace::matrix(int idx, int n_rows, int n_cols)
+    {
+        SFEM_CHECK_INDEX(idx, static_cast<int>(matrices_.size()));
+        matrices_[idx].resize(n_rows, n_cols);
+        return matrices_[idx];
+    }
+    //=============================================================================
+    std::vector<ElementWorkspace> create_workspaces()
+    {
+        return std::vector<ElementWorkspace>(omp::n_threads());
+    }
 }
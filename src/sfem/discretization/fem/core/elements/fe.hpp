@@ -5,11 +5,14 @@
 #include <sfem/la/native/dense_matrix.hpp>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <atomic>
 
 namespace sfem::fem
 {
-    // Forward declaration
+    // Forward declarations
     class FEData;
+    class TensorProductBasis;
 
     /// @brief Finite element ABC
     class FiniteElement
@@ -38,8 +41,30 @@ namespace sfem::fem
         /// @brief Evaluate the element coordinate transform for a given point
         /// @note The physical dimension must be greater than or equal to the element's reference
         /// dimension
-        virtual FEData transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
-                                 std::span<const std::array<real_t, 3>> elem_pts) const = 0;
+        FEData transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
+                         std::span<const std::array<real_t, 3>> elem_pts) const;
+
+        /// @brief Evaluate the element coordinate transform for a given point,
+        /// reusing the storage of existing transform data
+        /// @note The physical dimension must be greater than or equal to the element's reference
+        /// dimension
+        virtual void transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
+                               std::span<const std::array<real_t, 3>> elem_pts,
+                               FEData &data) const = 0;
+
+        /// @brief Evaluate the element coordinate transform at an integration point
+        /// @param qpt_idx Index of the point in the element's integration rule
+        /// @note The shape functions are read from the tables (see shape_table)
+        FEData transform(int elem_idx, int pdim, int qpt_idx,
+                         std::span<const std::array<real_t, 3>> elem_pts) const;
+
+        /// @brief Evaluate the element coordinate transform at an integration point,
+        /// reusing the storage of existing transform data
+        /// @param qpt_idx Index of the point in the element's integration rule
+        /// @note The shape functions are read from the tables (see shape_table)
+        virtual void transform(int elem_idx, int pdim, int qpt_idx,
+                               std::span<const std::array<real_t, 3>> elem_pts,
+                               FEData &data) const = 0;
 
         /// @brief Evaluate the element's shape functions at a given point
         virtual void eval_shape(const std::array<real_t, 3> &pt,
@@ -49,6 +74,25 @@ namespace sfem::fem
         virtual void eval_shape_grad(const std::array<real_t, 3> &pt,
                                      la::DenseMatrix &dNdx) const = 0;
 
+        /// @brief Get the tabulated shape function values (size n_nodes) at an integration point
+        /// @param qpt_idx Index of the point in the element's integration rule
+        /// @note The shape functions and their gradients are tabulated at the points of the
+        /// integration rule on first call, and again if its number of points has changed since
+        /// (see IntegrationRule::set_n_points)
+        std::span<const real_t> shape_table(int qpt_idx) const;
+
+        /// @brief Get the tabulated shape function gradients w.r.t. natural coordinates
+        /// (size n_nodes x dim, row-major) at an integration point
+        /// @param qpt_idx Index of the point in the element's integration rule
+        std::span<const real_t> shape_grad_table(int qpt_idx) const;
+
+        /// @brief Get the element's tensor-product basis, used for sum-factorized evaluation
+        /// @return The basis, or nullptr if the element is not a tensor-product element
+        /// (see TensorProductBasis::is_tensor_product)
+        /// @note The basis is created on first call, and recreated if the number of points
+        /// of the integration rule has changed since (see IntegrationRule::set_n_points)
+        const TensorProductBasis *tensor_product_basis() const;
+
     protected:
         /// @brief The element's reference cell type
         mesh::CellType cell_type_;
@@ -58,6 +102,34 @@ namespace sfem::fem
 
         /// @brief The integration rule (or quadrature)
         std::unique_ptr<IntegrationRule> integration_rule_;
+
+    private:
+        /// @brief Tabulate the shape functions and their gradients at the points
+        /// of the integration rule, unless they are already tabulated for its current
+        /// number of points
+        void tabulate() const;
+
+        /// @brief Guards the (lazy) tabulation
+        mutable std::mutex table_mutex_;
+
+        /// @brief Number of tabulated points (-1 if not yet tabulated)
+        mutable std::atomic<int> table_n_points_ = -1;
+
+        /// @brief Shape function values for each tabulated point
+        mutable std::vector<real_t> N_table_;
+
+        /// @brief Shape function gradients (natural) for each tabulated point
+        mutable std::vector<real_t> dNdxi_table_;
+
+        /// @brief Guards the (lazy) creation of the tensor-product basis
+        mutable std::mutex tp_mutex_;
+
+        /// @brief Number of integration points the tensor-product basis was created for
+        /// (-1 if not yet created)
+        mutable std::atomic<int> tp_n_points_ = -1;
+
+        /// @brief Tensor-product basis (if applicable)
+        mutable std::shared_ptr<const TensorProductBasis> tp_basis_;
     };
 
     /// @brief Finite element coordinate transform data
@@ -65,6 +137,10 @@ namespace sfem::fem
     {
         FEData(int elem_idx, int n_nodes, int pdim, int gdim);
 
+        /// @brief Reset the data for a (possibly different) element,
+        /// reusing the existing storage if possible
+        void reset(int elem_idx, int n_nodes, int pdim, int gdim);
+
         /// @brief Current element index
         int elem_idx;
 
@@ -80,6 +156,11 @@ namespace sfem::fem
         /// @brief Transform evaluation point
         std::array<real_t, 3> pt;
 
+        /// @brief Integration rule and index of the evaluation point in it,
+        /// if the transform was evaluated at an integration point (else nullptr and -1)
+        const IntegrationRule *int_rule;
+        int qpt_idx;
+
         /// @brief Natural-to-physical Jacobian determinant
         real_t detJ;
 
@@ -99,5 +180,34 @@ namespace sfem::fem
         la::DenseMatrix dNdX;
     };
 
+    /// @brief Scratch storage for element computations, i.e. transform data,
+    /// element DoF points and element matrices, which is reused from element to element.
+    /// Each thread of an assembly loop should use its own workspace
+    class ElementWorkspace
+    {
+    public:
+        /// @brief Create an ElementWorkspace
+        /// @param n_matrices Number of scratch matrices
+        ElementWorkspace(int n_matrices = 8);
+
+        /// @brief Get a scratch matrix with given dimensions, with all values set to zero
+        /// @param idx Matrix index
+        /// @note References to the other scratch matrices remain valid
+        la::DenseMatrix &matrix(int idx, int n_rows, int n_cols);
+
+        /// @brief Transform data
+        FEData data;
+
+        /// @brief Element DoF points
+        std::vector<std::array<real_t, 3>> pts;
+
+    private:
+        /// @brief Scratch matrices
+        std::vector<la::DenseMatrix> matrices_;
+    };
+
+    /// @brief Create one element workspace per thread, to be indexed by omp::thread_id()
+    std::vector<ElementWorkspace> create_workspaces();
+
     using ElementOperator = std::function<void(const FEData &data, la::DenseMatrix &f)>;
 }
\ No newline at end of file
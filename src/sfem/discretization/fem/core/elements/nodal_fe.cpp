@@ -1,42 +1,31 @@
 #include "nodal_fe.hpp"
+#include <sfem/la/native/dense_matrix_utils.hpp>
 
 namespace sfem::fem
 {
     //=============================================================================
-    NodalFiniteElement::NodalFiniteElement(mesh::CellType cell_type, int order,
-                                           std::unique_ptr<IntegrationRule> &&integration_rule)
-        : FiniteElement(cell_type, order, std::move(integration_rule))
-    {
-    }
-    //=============================================================================
-    int NodalFiniteElement::n_nodes() const
-    {
-        return dof::cell_num_dof(cell_type_, order_);
-    }
-    //=============================================================================
-    FEData NodalFiniteElement::transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
-                                         std::span<const std::array<real_t, 3>> elem_pts) const
+    /// @brief Complete the transform data given the shape functions and their gradients
+    /// w.r.t natural coordinates, i.e. evaluate the Jacobian, its inverse and determinant,
+    /// and the shape function gradients w.r.t physical coordinates
+    static void transform_geometry(std::span<const std::array<real_t, 3>> elem_pts, FEData &data)
     {
-        FEData data(elem_idx, n_nodes(), pdim, dim());
-        data.pt = pt;
-
-        // Evaluate the shape function and its gradient w.r.t natural coordinates
-        eval_shape(pt, data.N);
-        eval_shape_grad(pt, data.dNdxi);
+        const int n_nodes = data.n_nodes;
+        const int pdim = data.pdim;
+        const int gdim = data.gdim;
 
         // Return early for point elements
-        if (dim() == 0)
+        if (gdim == 0)
         {
             data.detJ = 1.0;
-            return data;
+            return;
         }
 
         // Evaluate the natural to physical Jacobian
         for (int i = 0; i < pdim; i++)
         {
-            for (int j = 0; j < dim(); j++)
+            for (int j = 0; j < gdim; j++)
             {
-                for (int k = 0; k < n_nodes(); k++)
+                for (int k = 0; k < n_nodes; k++)
                 {
                     data.dXdxi(i, j) += data.dNdxi(k, j) * elem_pts[k][i];
                 }
@@ -45,7 +34,14 @@ namespace sfem::fem
 
         // Evaluate the physical to natural, or inverse, Jacobian
         // and the determinant
-        std::tie(data.dxidX, data.detJ) = data.dXdxi.invert();
+        if (pdim == gdim)
+        {
+            data.detJ = la::utils::inv(pdim, data.dXdxi.values(), data.dxidX.values());
+        }
+        else
+        {
+            data.detJ = la::utils::pinv(pdim, gdim, data.dXdxi.values(), data.dxidX.values());
+        }
 
         // Check for non-positive jacobian
         if (data.detJ <= 0)
@@ -55,8 +51,52 @@ namespace sfem::fem
         }
 
         // Evaluate the shape function gradient w.r.t physical coordinates
-        data.dNdX = data.dNdxi * data.dxidX;
+        la::utils::matmult(n_nodes, pdim, gdim,
+                           data.dNdxi.values(),
+                           data.dxidX.values(),
+                           data.dNdX.values());
+    }
+    //=============================================================================
+    NodalFiniteElement::NodalFiniteElement(mesh::CellType cell_type, int order,
+                                           std::unique_ptr<IntegrationRule> &&integration_rule)
+        : FiniteElement(cell_type, order, std::move(integration_rule))
+    {
+    }
+    //=============================================================================
+    int NodalFiniteElement::n_nodes() const
+    {
+        return dof::cell_num_dof(cell_type_, order_);
+    }
+    //=============================================================================
+    void NodalFiniteElement::transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
+                                       std::span<const std::array<real_t, 3>> elem_pts,
+                                       FEData &data) const
+    {
+        data.reset(elem_idx, n_nodes(), pdim, dim());
+        data.pt = pt;
+
+        // Evaluate the shape function and its gradient w.r.t natural coordinates
+        eval_shape(pt, data.N);
+        eval_shape_grad(pt, data.dNdxi);
+
+        transform_geometry(elem_pts, data);
+    }
+    //=============================================================================
+    void NodalFiniteElement::transform(int elem_idx, int pdim, int qpt_idx,
+                                       std::span<const std::array<real_t, 3>> elem_pts,
+                                       FEData &data) const
+    {
+        data.reset(elem_idx, n_nodes(), pdim, dim());
+        data.pt = integration_rule_->point(qpt_idx);
+        data.int_rule = integration_rule_.get();
+        data.qpt_idx = qpt_idx;
+
+        // Read the shape function and its gradient w.r.t natural coordinates from the tables
+        const auto N = shape_table(qpt_idx);
+        const auto dNdxi = shape_grad_table(qpt_idx);
+        std::copy(N.begin(), N.end(), data.N.values().begin());
+        std::copy(dNdxi.begin(), dNdxi.end(), data.dNdxi.values().begin());
 
-        return data;
+        transform_geometry(elem_pts, data);
     }
 }
\ No newline at end of file
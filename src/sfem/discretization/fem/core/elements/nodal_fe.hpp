@@ -14,7 +14,14 @@ namespace sfem::fem
 
         int n_nodes() const override;
 
-        FEData transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
-                         std::span<const std::array<real_t, 3>> elem_pts) const override;
+        using FiniteElement::transform;
+
+        void transform(int elem_idx, int pdim, const std::array<real_t, 3> &pt,
+                       std::span<const std::array<real_t, 3>> elem_pts,
+                       FEData &data) const override;
+
+        void transform(int elem_idx, int pdim, int qpt_idx,
+                       std::span<const std::array<real_t, 3>> elem_pts,
+                       FEData &data) const override;
     };
 }
\ No newline at end of file
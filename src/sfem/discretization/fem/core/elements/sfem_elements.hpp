@@ -3,4 +3,6 @@
 #include <sfem/discretization/fem/core/elements/fe.hpp>
 #include <sfem/discretization/fem/core/elements/nodal_fe.hpp>
 #include <sfem/discretization/fem/core/elements/fixed_order.hpp>
-#include <sfem/discretization/fem/core/elements/fe_factory.hpp>
\ No newline at end of file
+#include <sfem/discretization/fem/core/elements/fe_factory.hpp>
+#include <sfem/discretization/fem/core/elements/tensor_product.hpp>
+#include <sfem/discretization/fem/core/elements/element_dispatch.hpp>
\ No newline at end of file
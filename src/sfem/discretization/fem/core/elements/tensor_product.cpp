@@ -0,0 +1,296 @@
+#include "tensor_product.hpp"
+#include <sfem/discretization/fem/core/elements/fe_factory.hpp>
+#include <sfem/discretization/fem/core/quadrature/gauss.hpp>
+#include <sfem/base/error.hpp>
+#include <array>
+#include <cmath>
+
+namespace sfem::fem
+{
+    //=============================================================================
+    /// @brief Apply a 1D matrix M (or its transpose) along the middle direction of an array
+    /// viewed as (n_outer x n_in x n_inner), i.e. out(a, r, c) (+)= sum_s M(r, s) * in(a, s, c)
+    /// @param A Matrix (n_points_1d x n_nodes_1d, row-major)
+    /// @param transpose Whether M = A^T (M = A otherwise)
+    /// @param accumulate Whether to add to the output (it is overwritten otherwise)
+    static void contract(std::span<const real_t> A, int n_rows, int n_cols, bool transpose,
+                         int n_outer, int n_inner,
+                         const real_t *in, real_t *out, bool accumulate)
+    {
+        // Size of M and strides of its entries in A
+        const int n_out = transpose ? n_cols : n_rows;
+        const int n_in = transpose ? n_rows : n_cols;
+        const int stride_r = transpose ? 1 : n_cols;
+        const int stride_s = transpose ? n_cols : 1;
+
+        for (int a = 0; a < n_outer; a++)
+        {
+            for (int r = 0; r < n_out; r++)
+            {
+                real_t *out_ar = out + (a * n_out + r) * n_inner;
+                if (!accumulate)
+                {
+                    std::fill(out_ar, out_ar + n_inner, 0.0);
+                }
+                for (int s = 0; s < n_in; s++)
+                {
+                    const real_t m_rs = A[r * stride_r + s * stride_s];
+                    const real_t *in_as = in + (a * n_in + s) * n_inner;
+                    for (int c = 0; c < n_inner; c++)
+                    {
+                        out_ar[c] += m_rs * in_as[c];
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    /// @brief Integer power
+    static int ipow(int base, int exp)
+    {
+        int result = 1;
+        for (int i = 0; i < exp; i++)
+        {
+            result *= base;
+        }
+        return result;
+    }
+    //=============================================================================
+    bool TensorProductBasis::is_tensor_product(const FiniteElement &element)
+    {
+        const auto cell_type = element.cell_type();
+        if (cell_type == mesh::CellType::quadrilateral)
+        {
+            return dynamic_cast<const quadrature::Gauss<2> *>(element.integration_rule()) != nullptr;
+        }
+        if (cell_type == mesh::CellType::hexahedron)
+        {
+            return dynamic_cast<const quadrature::Gauss<3> *>(element.integration_rule()) != nullptr;
+        }
+        return false;
+    }
+    //=============================================================================
+    TensorProductBasis::TensorProductBasis(const FiniteElement &element)
+        : dim_(element.dim()),
+          n_nodes_1d_(element.order() + 1)
+    {
+        if (!is_tensor_product(element))
+        {
+            SFEM_ERROR(std::format("{} element of order {} is not a tensor-product element\n",
+                                   mesh::cell_type_str(element.cell_type()), element.order()));
+        }
+        n_points_1d_ = (dim_ == 2)
+                           ? static_cast<const quadrature::Gauss<2> *>(element.integration_rule())->n_points_1d()
+                           : static_cast<const quadrature::Gauss<3> *>(element.integration_rule())->n_points_1d();
+        if (n_nodes_1d_ > max_n_1d or n_points_1d_ > max_n_1d)
+        {
+            SFEM_ERROR(std::format("Tensor-product evaluation supports up to {} nodes and points per direction\n",
+                                   max_n_1d));
+        }
+
+        // 1D basis of the same order, evaluated at the 1D Gauss points
+        const auto line = create_nodal_element(mesh::CellType::line, element.order());
+        const quadrature::Gauss<1> rule_1d(n_points_1d_ - 1);
+        la::DenseMatrix N(n_nodes_1d_, 1);
+        la::DenseMatrix dNdxi(n_nodes_1d_, 1);
+        B_.resize(n_points_1d_ * n_nodes_1d_);
+        D_.resize(n_points_1d_ * n_nodes_1d_);
+        for (int q = 0; q < n_points_1d_; q++)
+        {
+            line->eval_shape(rule_1d.point(q), N);
+            line->eval_shape_grad(rule_1d.point(q), dNdxi);
+            for (int i = 0; i < n_nodes_1d_; i++)
+            {
+                B_[q * n_nodes_1d_ + i] = N(i, 0);
+                D_[q * n_nodes_1d_ + i] = dNdxi(i, 0);
+            }
+        }
+
+        // 1D node coordinates, i.e. the end points followed by the equispaced interior points
+        std::vector<real_t> nodes_1d(n_nodes_1d_);
+        nodes_1d[0] = -1.0;
+        nodes_1d[1] = 1.0;
+        for (int i = 2; i < n_nodes_1d_; i++)
+        {
+            nodes_1d[i] = -1.0 + 2.0 * (i - 1) / (n_nodes_1d_ - 1);
+        }
+
+        // Element node at each tensor-product node, i.e. the
+        // (only) shape function equal to one at that node
+        const int n_nodes = element.n_nodes();
+        perm_.assign(n_nodes, -1);
+        std::vector<bool> found(n_nodes, false);
+        la::DenseMatrix N_elem(n_nodes, 1);
+        for (int l = 0; l < n_nodes; l++)
+        {
+            std::array<real_t, 3> pt = {0.0, 0.0, 0.0};
+            for (int dir = 0, rem = l; dir < dim_; dir++, rem /= n_nodes_1d_)
+            {
+                pt[dir] = nodes_1d[rem % n_nodes_1d_];
+            }
+
+            element.eval_shape(pt, N_elem);
+            for (int k = 0; k < n_nodes; k++)
+            {
+                if (std::abs(N_elem(k, 0) - 1.0) < 1e-8)
+                {
+                    perm_[l] = k;
+                }
+            }
+            if (perm_[l] < 0 or found[perm_[l]])
+            {
+                SFEM_ERROR(std::format("{} element of order {} is not a tensor-product element\n",
+                                       mesh::cell_type_str(element.cell_type()), element.order()));
+            }
+            found[perm_[l]] = true;
+        }
+    }
+    //=============================================================================
+    int TensorProductBasis::dim() const
+    {
+        return dim_;
+    }
+    //=============================================================================
+    int TensorProductBasis::n_nodes_1d() const
+    {
+        return n_nodes_1d_;
+    }
+    //=============================================================================
+    int TensorProductBasis::n_points_1d() const
+    {
+        return n_points_1d_;
+    }
+    //=============================================================================
+    void TensorProductBasis::interpolate(std::span<const real_t> u,
+                                         std::span<real_t> u_q,
+                                         std::span<real_t> grad_q) const
+    {
+        const int n = n_nodes_1d_;
+        const int m = n_points_1d_;
+        const int n_points = ipow(m, dim_);
+        SFEM_CHECK_SIZES(perm_.size(), u.size());
+        SFEM_CHECK_SIZES(n_points, u_q.size());
+        const bool compute_grad = !grad_q.empty();
+        if (compute_grad)
+        {
+            SFEM_CHECK_SIZES(n_points * dim_, grad_q.size());
+        }
+
+        // Intermediate arrays, each tagged with the direction that has been
+        // differentiated (or -1 if none). Directions are contracted one at a time:
+        // untagged arrays yield a value and a derivative array, tagged arrays only a value array
+        std::array<std::array<real_t, max_size>, 4> bufs[2];
+        std::array<int, 4> tags[2];
+        int n_arrays = 1;
+        tags[0][0] = -1;
+        for (std::size_t l = 0; l < perm_.size(); l++)
+        {
+            bufs[0][0][l] = u[perm_[l]];
+        }
+
+        for (int dir = 0; dir < dim_; dir++)
+        {
+            const auto &in = bufs[dir % 2];
+            auto &out = bufs[(dir + 1) % 2];
+            const auto &in_tags = tags[dir % 2];
+            auto &out_tags = tags[(dir + 1) % 2];
+            const int n_inner = ipow(m, dir);
+            const int n_outer = ipow(n, dim_ - 1 - dir);
+
+            int n_out = 0;
+            for (int j = 0; j < n_arrays; j++)
+            {
+                contract(B_, m, n, false, n_outer, n_inner, in[j].data(), out[n_out].data(), false);
+                out_tags[n_out++] = in_tags[j];
+                if (compute_grad and in_tags[j] < 0)
+                {
+                    contract(D_, m, n, false, n_outer, n_inner, in[j].data(), out[n_out].data(), false);
+                    out_tags[n_out++] = dir;
+                }
+            }
+            n_arrays = n_out;
+        }
+
+        const auto &result = bufs[dim_ % 2];
+        const auto &result_tags = tags[dim_ % 2];
+        for (int j = 0; j < n_arrays; j++)
+        {
+            for (int q = 0; q < n_points; q++)
+            {
+                if (result_tags[j] < 0)
+                {
+                    u_q[q] = result[j][q];
+                }
+                else
+                {
+                    grad_q[q * dim_ + result_tags[j]] = result[j][q];
+                }
+            }
+        }
+    }
+    //=============================================================================
+    void TensorProductBasis::integrate(std::span<const real_t> f,
+                                       std::span<const real_t> g,
+                                       std::span<real_t> y) const
+    {
+        const int n = n_nodes_1d_;
+        const int m = n_points_1d_;
+        const int n_points = ipow(m, dim_);
+        SFEM_CHECK_SIZES(perm_.size(), y.size());
+        if (!f.empty())
+        {
+            SFEM_CHECK_SIZES(n_points, f.size());
+        }
+        if (!g.empty())
+        {
+            SFEM_CHECK_SIZES(n_points * dim_, g.size());
+        }
+
+        // Array of the function values (index 0, zero if not provided) and of
+        // each gradient component (index 1 + direction). Directions are contracted
+        // in reverse order, and the gradient component of each direction is merged
+        // into the value array once that direction is contracted
+        std::array<std::array<real_t, max_size>, 4> bufs[2];
+        auto &init = bufs[0];
+        for (int q = 0; q < n_points; q++)
+        {
+            init[0][q] = f.empty() ? 0.0 : f[q];
+            for (int dir = 0; dir < dim_; dir++)
+            {
+                init[1 + dir][q] = g.empty() ? 0.0 : g[q * dim_ + dir];
+            }
+        }
+
+        for (int dir = dim_ - 1, stage = 0; dir >= 0; dir--, stage++)
+        {
+            const auto &in = bufs[stage % 2];
+            auto &out = bufs[(stage + 1) % 2];
+            const int n_inner = ipow(m, dir);
+            const int n_outer = ipow(n, dim_ - 1 - dir);
+
+            if (!f.empty() or (!g.empty() and stage > 0))
+            {
+                contract(B_, m, n, true, n_outer, n_inner, in[0].data(), out[0].data(), false);
+            }
+            else
+            {
+                std::fill(out[0].begin(), out[0].begin() + n_outer * n * n_inner, 0.0);
+            }
+
+            if (!g.empty())
+            {
+                contract(D_, m, n, true, n_outer, n_inner, in[1 + dir].data(), out[0].data(), true);
+                for (int j = 0; j < dir; j++)
+                {
+                    contract(B_, m, n, true, n_outer, n_inner, in[1 + j].data(), out[1 + j].data(), false);
+                }
+            }
+        }
+
+        const auto &result = bufs[dim_ % 2][0];
+        for (std::size_t l = 0; l < perm_.size(); l++)
+        {
+            y[perm_[l]] += result[l];
+        }
+    }
+}
\ No newline at end of file
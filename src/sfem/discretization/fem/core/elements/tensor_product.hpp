@@ -0,0 +1,82 @@
+#pragma once
+
+#include <sfem/base/config.hpp>
+#include <span>
+#include <vector>
+
+namespace sfem::fem
+{
+    // Forward declaration
+    class FiniteElement;
+
+    /// @brief Tensor-product (sum-factorized) evaluation for quadrilateral and hexahedral
+    /// elements with Gauss integration rules.
+    ///
+    /// The shape functions are products of 1D Lagrange bases, and the Gauss points are
+    /// products of 1D Gauss points. Thus, values and gradients at all integration points
+    /// are evaluated by contracting one direction at a time with the (n_points_1d x n_nodes_1d)
+    /// 1D matrices, i.e. with O(p^(d+1)) instead of O(p^(2d)) work per element
+    class TensorProductBasis
+    {
+    public:
+        /// @brief Maximum number of nodes or integration points per direction
+        static constexpr int max_n_1d = 5;
+
+        /// @brief Maximum number of nodes or integration points per element
+        static constexpr int max_size = max_n_1d * max_n_1d * max_n_1d;
+
+        /// @brief Create the tensor-product basis of an element
+        /// @note Raises an error if the element is not a tensor-product element
+        TensorProductBasis(const FiniteElement &element);
+
+        /// @brief Check whether an element is a tensor-product element, i.e. a
+        /// quadrilateral or hexahedral element with a Gauss integration rule
+        static bool is_tensor_product(const FiniteElement &element);
+
+        /// @brief Get the dimension
+        int dim() const;
+
+        /// @brief Get the number of nodes per direction
+        int n_nodes_1d() const;
+
+        /// @brief Get the number of integration points per direction
+        int n_points_1d() const;
+
+        /// @brief Evaluate a function and its gradient (natural) at the integration points
+        /// @param u Nodal values (element node ordering)
+        /// @param u_q Values at the integration points
+        /// @param grad_q Gradients at the integration points (n_points x dim, row-major),
+        /// or an empty span if not required
+        void interpolate(std::span<const real_t> u,
+                         std::span<real_t> u_q,
+                         std::span<real_t> grad_q) const;
+
+        /// @brief Integrate data at the integration points against the shape functions
+        /// and their gradients (natural), i.e. the transpose of interpolate():
+        /// y_k += sum_q (N_k(q) * f_q + sum_i dN_k/dxi_i(q) * g_qi)
+        /// @param f Data multiplying the shape functions (n_points), or an empty span
+        /// @param g Data multiplying the shape function gradients (n_points x dim, row-major),
+        /// or an empty span
+        /// @param y Nodal values (element node ordering)
+        void integrate(std::span<const real_t> f,
+                       std::span<const real_t> g,
+                       std::span<real_t> y) const;
+
+    private:
+        /// @brief Dimension
+        int dim_;
+
+        /// @brief Number of nodes and integration points per direction
+        int n_nodes_1d_;
+        int n_points_1d_;
+
+        /// @brief 1D shape functions and their derivatives at the 1D integration points
+        /// (n_points_1d x n_nodes_1d, row-major)
+        std::vector<real_t> B_;
+        std::vector<real_t> D_;
+
+        /// @brief Element node index for each lexicographic node index
+        /// (i.e. i_x + n * i_y + n^2 * i_z)
+        std::vector<int> perm_;
+    };
+}
\ No newline at end of file
@@ -60,9 +60,16 @@ namespace sfem::fem
     {
         Axb_->reset();
 
+        // For native systems, element matrices are scattered
+        // using the cell-to-CSR map of the field's space
+        auto native_Axb = std::dynamic_pointer_cast<la::NativeLinearSystem>(Axb_);
+        const CellMatSet lhs = (native_Axb and native_Axb->A().connectivity() == phi_.space()->connectivity()[1])
+                                   ? CellMatSet(native_Axb->A(), *phi_.space())
+                                   : CellMatSet(Axb_->lhs());
+
         for (const FEKernel &kernel : kernels_)
         {
-            kernel(Axb_->lhs(), Axb_->rhs());
+            kernel(lhs, Axb_->rhs());
         }
 
         Axb_->assemble();
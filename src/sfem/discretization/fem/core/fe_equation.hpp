@@ -1,12 +1,13 @@
 #pragma once
 
 #include <sfem/discretization/fem/core/fe_field.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
 #include <sfem/discretization/fem/core/dirichlet_bc.hpp>
 #include <sfem/la/native/linear_system.hpp>
 
 namespace sfem::fem
 {
-    using FEKernel = std::function<void(la::MatSet, la::VecSet)>;
+    using FEKernel = std::function<void(CellMatSet, la::VecSet)>;
 
     class Equation
     {
@@ -19,6 +19,21 @@ namespace sfem::fem
         return static_cast<int>(components_.size());
     }
     //=============================================================================
+    real_t Field::cell_qpt_value(int cell_idx, const IntegrationRule &int_rule,
+                                 int qpt_idx, int comp_idx) const
+    {
+        return cell_value(cell_idx, int_rule.point(qpt_idx), comp_idx);
+    }
+    //=============================================================================
+    real_t Field::cell_value_at(const FEData &data, int comp_idx) const
+    {
+        if (data.int_rule)
+        {
+            return cell_qpt_value(data.elem_idx, *data.int_rule, data.qpt_idx, comp_idx);
+        }
+        return cell_value(data.elem_idx, data.pt, comp_idx);
+    }
+    //=============================================================================
     ConstantField::ConstantField(const std::vector<std::string> &components,
                                  const std::vector<real_t> &value)
         : Field(components),
@@ -37,6 +52,11 @@ namespace sfem::fem
         return value_[comp_idx];
     }
     //=============================================================================
+    real_t ConstantField::cell_qpt_value(int, const IntegrationRule &, int, int comp_idx) const
+    {
+        return value_[comp_idx];
+    }
+    //=============================================================================
     real_t ConstantField::facet_value(int, const std::array<real_t, 3> &, int comp_idx) const
     {
         return value_[comp_idx];
@@ -118,6 +138,28 @@ namespace sfem::fem
         return value;
     }
     //=============================================================================
+    real_t FEField::cell_qpt_value(int cell_idx, const IntegrationRule &int_rule,
+                                   int qpt_idx, int comp_idx) const
+    {
+        const auto cell_type = topo_->cells().at(cell_idx).type;
+        const auto element = V_->element(cell_type);
+
+        // The tables are those of the element's own integration rule
+        if (element->integration_rule() != &int_rule)
+        {
+            return cell_value(cell_idx, int_rule.point(qpt_idx), comp_idx);
+        }
+
+        const auto elem_dof = V_->cell_dof(cell_idx);
+        const auto N = element->shape_table(qpt_idx);
+        real_t value = 0.0;
+        for (int i = 0; i < element->n_nodes(); i++)
+        {
+            value += (*dof_values_)(elem_dof[i], comp_idx) * N[i];
+        }
+        return value;
+    }
+    //=============================================================================
     real_t FEField::facet_value(int facet_idx, const std::array<real_t, 3> &pt, int comp_idx) const
     {
         const int dim = topo_->dim();
@@ -25,6 +25,25 @@ namespace sfem::fem
                                   const std::array<real_t, 3> &pt,
                                   int comp_idx = 0) const = 0;
 
+        /// @brief Evaluate the value of the field at an integration point in a cell
+        /// @param cell_idx Cell index
+        /// @param int_rule Integration rule
+        /// @param qpt_idx Index of the point in the integration rule
+        /// @param comp_idx Component index
+        /// @return Field value
+        /// @note By default, the field is evaluated at the point's coordinates
+        virtual real_t cell_qpt_value(int cell_idx,
+                                      const IntegrationRule &int_rule,
+                                      int qpt_idx,
+                                      int comp_idx = 0) const;
+
+        /// @brief Evaluate the value of the field at the evaluation point of a transform,
+        /// i.e. at its integration point if it was evaluated at one (see cell_qpt_value)
+        /// @param data Transform data
+        /// @param comp_idx Component index
+        /// @return Field value
+        real_t cell_value_at(const FEData &data, int comp_idx = 0) const;
+
         /// @brief Evaluate the value of the field for a given
         /// reference point on a facet
         /// @param facet_idx Facet index
@@ -72,6 +91,11 @@ namespace sfem::fem
                           const std::array<real_t, 3> &pt,
                           int comp_idx = 0) const override;
 
+        real_t cell_qpt_value(int cell_idx,
+                              const IntegrationRule &int_rule,
+                              int qpt_idx,
+                              int comp_idx = 0) const override;
+
         real_t facet_value(int facet_idx,
                            const std::array<real_t, 3> &pt,
                            int comp_idx = 0) const override;
@@ -109,6 +133,13 @@ namespace sfem::fem
                           const std::array<real_t, 3> &pt,
                           int comp_idx = 0) const override;
 
+        /// @note The shape functions are read from the element's tables
+        /// if the integration rule is that of the element
+        real_t cell_qpt_value(int cell_idx,
+                              const IntegrationRule &int_rule,
+                              int qpt_idx,
+                              int comp_idx = 0) const override;
+
         real_t facet_value(int facet_idx,
                            const std::array<real_t, 3> &pt,
                            int comp_idx = 0) const override;
@@ -1,4 +1,5 @@
 #include "fe_space.hpp"
+#include <sfem/graph/coloring.hpp>
 #include <set>
 
 namespace sfem::fem
@@ -68,6 +69,57 @@ namespace sfem::fem
         return connectivity_[0]->links(cell_idx);
     }
     //=============================================================================
+    std::span<const int> FESpace::cell_csr_idxs(int cell_idx) const
+    {
+        std::call_once(cell_csr_flag_, &FESpace::compute_cell_csr_idxs, this);
+        SFEM_CHECK_INDEX(cell_idx, connectivity_[0]->n_primary());
+        return {cell_csr_idxs_.data() + cell_csr_offsets_[cell_idx],
+                cell_csr_idxs_.data() + cell_csr_offsets_[cell_idx + 1]};
+    }
+    //=============================================================================
+    const graph::Connectivity &FESpace::cell_colors() const
+    {
+        std::call_once(cell_colors_flag_, [this]()
+                       { cell_colors_ = graph::greedy_coloring(*connectivity_[0]); });
+        return cell_colors_;
+    }
+    //=============================================================================
+    const std::vector<std::vector<mesh::utils::CellBatch>> &FESpace::cell_batches() const
+    {
+        std::call_once(cell_batches_flag_, [this]()
+                       { cell_batches_ = mesh::utils::create_cell_batches(*mesh_, cell_colors()); });
+        return cell_batches_;
+    }
+    //=============================================================================
+    void FESpace::compute_cell_csr_idxs() const
+    {
+        const auto &cell_to_dof = *connectivity_[0];
+        const auto &dof_to_dof = *connectivity_[1];
+        const int n_cells = cell_to_dof.n_primary();
+
+        cell_csr_offsets_.assign(n_cells + 1, 0);
+        for (int i = 0; i < n_cells; i++)
+        {
+            const int n_dof = cell_to_dof.n_links(i);
+            cell_csr_offsets_[i + 1] = cell_csr_offsets_[i] + n_dof * n_dof;
+        }
+
+        cell_csr_idxs_.resize(cell_csr_offsets_.back());
+        for (int i = 0; i < n_cells; i++)
+        {
+            auto dof = cell_to_dof.links(i);
+            int pos = cell_csr_offsets_[i];
+            for (int row : dof)
+            {
+                const int offset = dof_to_dof.offset(row);
+                for (int col : dof)
+                {
+                    cell_csr_idxs_[pos++] = offset + dof_to_dof.relative_index(row, col);
+                }
+            }
+        }
+    }
+    //=============================================================================
     std::vector<int> FESpace::facet_dof(int facet_idx) const
     {
         // Quick access
@@ -158,11 +210,17 @@ namespace sfem::fem
     }
     //=============================================================================
     std::vector<std::array<real_t, 3>> FESpace::cell_dof_points(int cell_idx) const
+    {
+        std::vector<std::array<real_t, 3>> points;
+        cell_dof_points(cell_idx, points);
+        return points;
+    }
+    //=============================================================================
+    void FESpace::cell_dof_points(int cell_idx, std::vector<std::array<real_t, 3>> &points) const
     {
         auto cell = mesh_->topology()->entity(cell_idx, mesh_->topology()->dim());
-        auto points = mesh_->entity_points(cell_idx, mesh_->topology()->dim());
+        mesh_->entity_points(cell_idx, mesh_->topology()->dim(), points);
         dof::compute_cell_dof_points(cell.type, order_, points);
-        return points;
     }
     //=============================================================================
     std::vector<std::array<real_t, 3>> FESpace::facet_dof_points(int facet_idx) const
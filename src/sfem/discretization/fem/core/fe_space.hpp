@@ -2,6 +2,8 @@
 
 #include <sfem/discretization/fem/core/elements/fe.hpp>
 #include <sfem/mesh/mesh.hpp>
+#include <sfem/mesh/utils/loop_utils.hpp>
+#include <mutex>
 
 namespace sfem::fem
 {
@@ -52,6 +54,23 @@ namespace sfem::fem
         /// @brief Get the DoF for the cell
         std::span<const int> cell_dof(int cell_idx) const;
 
+        /// @brief Get the positions of a cell's element matrix blocks
+        /// in the DoF-to-DoF connectivity array, i.e. entry i * n + j
+        /// corresponds to the row of the i-th and the column of the j-th cell DoF
+        /// @note Computed on first call, since it requires storage comparable
+        /// to that of a sparse matrix
+        std::span<const int> cell_csr_idxs(int cell_idx) const;
+
+        /// @brief Get a coloring of the cells, such that no two cells
+        /// of the same color share a DoF (color-to-cell connectivity)
+        /// @note Computed on first call
+        const graph::Connectivity &cell_colors() const;
+
+        /// @brief Get the cells of each color, split into batches of cells of the same type
+        /// (see mesh::utils::create_cell_batches)
+        /// @note Computed on first call
+        const std::vector<std::vector<mesh::utils::CellBatch>> &cell_batches() const;
+
         /// @brief Get the DoF for the facet
         std::vector<int> facet_dof(int facet_idx) const;
 
@@ -61,6 +80,9 @@ namespace sfem::fem
         /// @brief Get the coordinates of the DoF for a cell
         std::vector<std::array<real_t, 3>> cell_dof_points(int cell_idx) const;
 
+        /// @brief Get the coordinates of the DoF for a cell, reusing an existing vector
+        void cell_dof_points(int cell_idx, std::vector<std::array<real_t, 3>> &points) const;
+
         /// @brief Get the coordinates of the DoF for a facet
         std::vector<std::array<real_t, 3>> facet_dof_points(int facet_idx) const;
 
@@ -90,5 +112,30 @@ namespace sfem::fem
         /// @brief The finite element collection,
         /// i.e. a finite element corresponding to each suitable cell type
         FECollection fe_collection_;
+
+    private:
+        /// @brief Compute the cell-to-CSR scatter map
+        void compute_cell_csr_idxs() const;
+
+        /// @brief Guards the (lazy) computation of the cell-to-CSR scatter map
+        mutable std::once_flag cell_csr_flag_;
+
+        /// @brief Cell-to-CSR scatter map offsets
+        mutable std::vector<int> cell_csr_offsets_;
+
+        /// @brief Cell-to-CSR scatter map, i.e. the CSR block positions for each cell
+        mutable std::vector<int> cell_csr_idxs_;
+
+        /// @brief Guards the (lazy) computation of the cell coloring
+        mutable std::once_flag cell_colors_flag_;
+
+        /// @brief Color-to-cell connectivity
+        mutable graph::Connectivity cell_colors_;
+
+        /// @brief Guards the (lazy) computation of the cell batches
+        mutable std::once_flag cell_batches_flag_;
+
+        /// @brief Batches of cells of the same type, for each color
+        mutable std::vector<std::vector<mesh::utils::CellBatch>> cell_batches_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "matrix_free_operator.hpp"
+#include <sfem/mesh/utils/loop_utils.hpp>
+#include <sfem/parallel/omp.hpp>
+
+namespace sfem::fem
+{
+    //=============================================================================
+    /// @brief Loop over the cells of all batches, one color at a time,
+    /// processing the batches of each color in parallel
+    /// @param work Function to be executed for every cell,
+    /// given the batch geometry and the position of the cell in the batch
+    template <typename Work>
+    static void for_all_batch_cells(const std::vector<std::vector<CellGeometry>> &geometries,
+                                    Work &&work)
+    {
+        for (const auto &color_geometries : geometries)
+        {
+            const int n_batches = static_cast<int>(color_geometries.size());
+
+            SFEM_OMP(parallel for schedule(dynamic))
+            for (int i = 0; i < n_batches; i++)
+            {
+                const auto &geometry = color_geometries[i];
+                for (int c = 0; c < geometry.n_cells(); c++)
+                {
+                    work(geometry, c);
+                }
+            }
+        }
+    }
+    //=============================================================================
+    MatrixFreeOperator::MatrixFreeOperator(FEField phi)
+        : phi_(phi)
+    {
+        const auto V = phi_.space();
+        eliminated_.assign(V->index_map()->n_local() * phi_.n_comp(), false);
+        update_geometry();
+    }
+    //=============================================================================
+    FEField MatrixFreeOperator::field() const
+    {
+        return phi_;
+    }
+    //=============================================================================
+    std::shared_ptr<const IndexMap> MatrixFreeOperator::index_map() const
+    {
+        return phi_.space()->index_map();
+    }
+    //=============================================================================
+    int MatrixFreeOperator::block_size() const
+    {
+        return phi_.n_comp();
+    }
+    //=============================================================================
+    void MatrixFreeOperator::update_geometry()
+    {
+        const auto V = phi_.space();
+        const auto &batches = V->cell_batches();
+
+        geometries_.resize(batches.size());
+        for (std::size_t color = 0; color < batches.size(); color++)
+        {
+            const int n_batches = static_cast<int>(batches[color].size());
+            geometries_[color].resize(n_batches);
+
+            SFEM_OMP(parallel for schedule(dynamic))
+            for (int i = 0; i < n_batches; i++)
+            {
+                const auto &batch = batches[color][i];
+                geometries_[color][i].compute(*V, batch.type, batch.cells);
+            }
+        }
+    }
+    //=============================================================================
+    std::vector<ElementWorkspace> &MatrixFreeOperator::workspaces() const
+    {
+        if (static_cast<int>(workspaces_.size()) != omp::n_threads())
+        {
+            workspaces_ = create_workspaces();
+        }
+        return workspaces_;
+    }
+    //=============================================================================
+    void MatrixFreeOperator::eliminate_dofs(std::span<const int> idxs)
+    {
+        // Make the eliminated DoF consistent across processes,
+        // since processes may only be aware of a subset of their ghost DoF
+        la::Vector flags(index_map(), block_size());
+        for (int idx : idxs)
+        {
+            SFEM_CHECK_INDEX(idx, static_cast<int>(eliminated_.size()));
+            flags.values()[idx] = 1.0;
+        }
+        flags.assemble();
+        flags.update_ghosts();
+
+        for (std::size_t i = 0; i < eliminated_.size(); i++)
+        {
+            eliminated_[i] = eliminated_[i] or flags.values()[i] > 0;
+        }
+    }
+    //=============================================================================
+    void MatrixFreeOperator::apply(la::Vector &x, la::Vector &y) const
+    {
+        SFEM_CHECK_SIZES(block_size(), x.block_size());
+        SFEM_CHECK_SIZES(block_size(), y.block_size());
+        SFEM_CHECK_SIZES(eliminated_.size(), x.values().size());
+        SFEM_CHECK_SIZES(eliminated_.size(), y.values().size());
+
+        // Quick access
+        const auto V = phi_.space();
+        const int bs = block_size();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        x.update_ghosts();
+        y.set_all(0.0);
+
+        auto &workspaces = this->workspaces();
+        auto work = [&](const CellGeometry &geometry, int c)
+        {
+            auto &ws = workspaces[omp::thread_id()];
+            const auto elem_dof = V->cell_dof(geometry.cells()[c]);
+            const int n_nodes = static_cast<int>(elem_dof.size());
+            const int n_elem = n_nodes * bs;
+            auto &x_elem = ws.matrix(0, n_elem, 1);
+            auto &y_elem = ws.matrix(1, n_elem, 1);
+
+            // Gather the element values, with the eliminated columns set to zero
+            for (int i = 0; i < n_nodes; i++)
+            {
+                for (int k = 0; k < bs; k++)
+                {
+                    const int idx = elem_dof[i] * bs + k;
+                    x_elem(i * bs + k, 0) = eliminated_[idx] ? 0.0 : xv[idx];
+                }
+            }
+
+            apply_cell(geometry, c, x_elem.values(), y_elem.values());
+
+            // Scatter the element result, skipping the eliminated rows
+            for (int i = 0; i < n_nodes; i++)
+            {
+                for (int k = 0; k < bs; k++)
+                {
+                    const int idx = elem_dof[i] * bs + k;
+                    if (!eliminated_[idx])
+                    {
+                        yv[idx] += y_elem(i * bs + k, 0);
+                    }
+                }
+            }
+        };
+        for_all_batch_cells(geometries_, work);
+
+        // Add the contributions to ghost DoF to their owners
+        y.assemble();
+
+        // Identity rows for the eliminated DoF
+        const int n_owned = y.n_owned() * bs;
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (eliminated_[i])
+            {
+                yv[i] = xv[i];
+            }
+        }
+    }
+    //=============================================================================
+    void MatrixFreeOperator::diagonal(la::Vector &diag) const
+    {
+        SFEM_CHECK_SIZES(block_size(), diag.block_size());
+        SFEM_CHECK_SIZES(eliminated_.size(), diag.values().size());
+
+        // Quick access
+        const auto V = phi_.space();
+        const int bs = block_size();
+        real_t *dv = diag.values().data();
+
+        diag.set_all(0.0);
+
+        auto &workspaces = this->workspaces();
+        auto work = [&](const CellGeometry &geometry, int c)
+        {
+            auto &ws = workspaces[omp::thread_id()];
+            const auto elem_dof = V->cell_dof(geometry.cells()[c]);
+            const int n_nodes = static_cast<int>(elem_dof.size());
+            const int n_elem = n_nodes * bs;
+            auto &d_elem = ws.matrix(0, n_elem, 1);
+
+            cell_diagonal(geometry, c, d_elem.values());
+
+            for (int i = 0; i < n_nodes; i++)
+            {
+                for (int k = 0; k < bs; k++)
+                {
+                    dv[elem_dof[i] * bs + k] += d_elem(i * bs + k, 0);
+                }
+            }
+        };
+        for_all_batch_cells(geometries_, work);
+
+        // Add the contributions to ghost DoF to their owners
+        diag.assemble();
+
+        // Unit diagonal for the eliminated DoF
+        const int n_owned = diag.n_owned() * bs;
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (eliminated_[i])
+            {
+                dv[i] = 1.0;
+            }
+        }
+    }
+}
\ No newline at end of file
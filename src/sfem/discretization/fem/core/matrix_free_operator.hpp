@@ -0,0 +1,78 @@
+#pragma once
+
+#include <sfem/discretization/fem/core/fe_field.hpp>
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
+#include <sfem/la/native/linear_operator.hpp>
+
+namespace sfem::fem
+{
+    /// @brief Matrix-free linear operator for a finite element field, i.e. the action of
+    /// the global matrix computed cell-by-cell, without assembling or storing the matrix.
+    ///
+    /// The cell geometry is evaluated once for batches of cells of the same color and type,
+    /// and is reused for every application of the operator. Cells of the same color are
+    /// processed in parallel. Derived classes provide the action and the diagonal of the
+    /// element operators
+    class MatrixFreeOperator : public la::LinearOperator
+    {
+    public:
+        /// @brief Create a MatrixFreeOperator
+        /// @param phi Finite element field
+        MatrixFreeOperator(FEField phi);
+
+        /// @brief Get the field
+        FEField field() const;
+
+        std::shared_ptr<const IndexMap> index_map() const override;
+
+        int block_size() const override;
+
+        void apply(la::Vector &x, la::Vector &y) const override;
+
+        void diagonal(la::Vector &diag) const override;
+
+        /// @brief Re-evaluate the cell geometry
+        /// @note Should be called whenever the mesh points change
+        void update_geometry();
+
+        /// @brief Eliminate a set of DoF, i.e. replace the corresponding rows and columns
+        /// of the operator with those of the identity matrix (e.g. for Dirichlet B.C.)
+        /// @param idxs Local DoF indices, i.e. node index * n_comp + component index
+        /// (see DirichletBC::get_dofs_values)
+        void eliminate_dofs(std::span<const int> idxs);
+
+    protected:
+        /// @brief Apply the element operator of a cell, i.e. compute y += A_e * x
+        /// @param geometry Geometry of the cell's batch
+        /// @param cell Position of the cell in the batch
+        /// @param x Element values (node-major, i.e. node index * n_comp + component index)
+        /// @param y Element values of the result
+        virtual void apply_cell(const CellGeometry &geometry, int cell,
+                                std::span<const real_t> x,
+                                std::span<real_t> y) const = 0;
+
+        /// @brief Compute the diagonal of the element operator of a cell, i.e. d += diag(A_e)
+        /// @param geometry Geometry of the cell's batch
+        /// @param cell Position of the cell in the batch
+        /// @param d Element values of the diagonal
+        virtual void cell_diagonal(const CellGeometry &geometry, int cell,
+                                   std::span<real_t> d) const = 0;
+
+        /// @brief Field
+        FEField phi_;
+
+    private:
+        /// @brief Get the per-thread element workspaces, re-created if
+        /// the number of threads has changed (see omp::n_threads)
+        std::vector<ElementWorkspace> &workspaces() const;
+
+        /// @brief Cell geometry of each batch, for each color
+        std::vector<std::vector<CellGeometry>> geometries_;
+
+        /// @brief Whether each local DoF is eliminated
+        std::vector<bool> eliminated_;
+
+        /// @brief Per-thread element workspaces
+        mutable std::vector<ElementWorkspace> workspaces_;
+    };
+}
\ No newline at end of file
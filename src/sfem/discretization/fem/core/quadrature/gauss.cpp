@@ -116,11 +116,17 @@ namespace sfem::fem::quadrature
     template <std::size_t dim>
     void Gauss<dim>::set_n_points(int n_points)
     {
-        n_points_ = n_points * dim;
+        n_points_ = gauss_num_points<dim>(n_points - 1);
         order_ = n_points - 1;
     }
     //=============================================================================
     template <std::size_t dim>
+    int Gauss<dim>::n_points_1d() const
+    {
+        return order_ + 1;
+    }
+    //=============================================================================
+    template <std::size_t dim>
     real_t Gauss<dim>::weight(int i) const
     {
         const int p = order_ + 1;
@@ -13,6 +13,9 @@ namespace sfem::fem::quadrature
         /// @brief Set the number of integration points per direction
         void set_n_points(int n_points) override;
 
+        /// @brief Get the number of integration points per direction
+        int n_points_1d() const;
+
         real_t weight(int qpt_idx) const override;
         std::array<real_t, 3> point(int qpt_idx) const override;
 
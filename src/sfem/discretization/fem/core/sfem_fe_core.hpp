@@ -4,7 +4,10 @@
 #include <sfem/discretization/fem/core/elements/sfem_elements.hpp>
 #include <sfem/discretization/fem/core/utils/sfem_fem_utils.hpp>
 #include <sfem/discretization/fem/core/fe_space.hpp>
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
+#include <sfem/discretization/fem/core/matrix_free_operator.hpp>
 #include <sfem/discretization/fem/core/cg_space.hpp>
 #include <sfem/discretization/fem/core/fe_field.hpp>
 #include <sfem/discretization/fem/core/dirichlet_bc.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
 #include <sfem/discretization/fem/core/fe_equation.hpp>
\ No newline at end of file
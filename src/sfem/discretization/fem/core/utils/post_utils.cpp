@@ -1,5 +1,7 @@
 #include "post_utils.hpp"
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
 #include <sfem/mesh/utils/loop_utils.hpp>
+#include <sfem/parallel/omp.hpp>
 
 namespace sfem::fem
 {
@@ -13,42 +15,49 @@ namespace sfem::fem
 
         // Quick access
         const auto mesh = V.mesh();
-        const int dim = mesh->pdim();
         auto &F_values = F.dof_values();
 
-        la::DenseMatrix f(F.n_comp(), 1);
-        la::DenseMatrix fi(F.n_comp(), 1);
+        // Per-thread element workspaces and batched cell geometry
+        auto workspaces = create_workspaces();
+        std::vector<CellGeometry> geometries(omp::n_threads());
 
         auto work = [&](const mesh::Mesh &,
-                        const mesh::Region &,
-                        const mesh::Cell &cell,
-                        int cell_idx)
+                        mesh::CellType cell_type,
+                        std::span<const int> cells)
         {
-            const auto element = V.element(cell.type);
-            const auto int_rule = element->integration_rule();
-            const auto elem_pts = V.cell_dof_points(cell_idx);
-
-            f.set_all(0.0);
-            fi.set_all(0.0);
-            real_t vol = 0.0;
-            for (int qpt_idx = 0; qpt_idx < int_rule->n_points(); qpt_idx++)
-            {
-                const real_t qwt = int_rule->weight(qpt_idx);
-                const auto qpt = int_rule->point(qpt_idx);
-                const auto data = element->transform(cell_idx, dim, qpt, elem_pts);
-                const real_t Jwt = data.detJ * qwt;
-
-                op(data, fi);
-                f += fi * Jwt;
-                vol += Jwt;
-            }
+            auto &ws = workspaces[omp::thread_id()];
+            const auto &data = ws.data;
+
+            auto &geometry = geometries[omp::thread_id()];
+            geometry.compute(V, cell_type, cells);
 
-            for (int comp_idx = 0; comp_idx < F.n_comp(); comp_idx++)
+            for (int c = 0; c < geometry.n_cells(); c++)
             {
-                F_values(cell_idx, comp_idx) = f(comp_idx, 0) / std::abs(vol);
+                const int cell_idx = cells[c];
+
+                auto &f = ws.matrix(0, F.n_comp(), 1);
+                auto &fi = ws.matrix(1, F.n_comp(), 1);
+                real_t vol = 0.0;
+                for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+                {
+                    geometry.transform(c, qpt_idx, ws.data);
+                    const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                    op(data, fi);
+                    for (int comp_idx = 0; comp_idx < F.n_comp(); comp_idx++)
+                    {
+                        f(comp_idx, 0) += fi(comp_idx, 0) * Jwt;
+                    }
+                    vol += Jwt;
+                }
+
+                for (int comp_idx = 0; comp_idx < F.n_comp(); comp_idx++)
+                {
+                    F_values(cell_idx, comp_idx) = f(comp_idx, 0) / std::abs(vol);
+                }
             }
         };
-        mesh::utils::for_all_cells(*mesh, work);
+        mesh::utils::for_all_cell_batches(*mesh, work, V.cell_batches());
         F_values.update_ghosts();
     }
 }
\ No newline at end of file
@@ -1,8 +1,87 @@
 #include "diffusion.hpp"
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
+#include <sfem/discretization/fem/core/elements/element_dispatch.hpp>
+#include <sfem/discretization/fem/core/elements/tensor_product.hpp>
+#include <sfem/la/native/static_matrix.hpp>
 #include <sfem/mesh/utils/loop_utils.hpp>
+#include <sfem/parallel/omp.hpp>
 
 namespace sfem::fem
 {
+    //=============================================================================
+    /// @brief Get the inverse Jacobian of a cell at an integration point
+    static std::array<std::array<real_t, 3>, 3> cell_invJ(const CellGeometry &geometry,
+                                                          int cell, int qpt_idx)
+    {
+        std::array<std::array<real_t, 3>, 3> invJ{};
+        for (int i = 0; i < geometry.dim(); i++)
+        {
+            for (int j = 0; j < geometry.dim(); j++)
+            {
+                invJ[i][j] = geometry.invJ(qpt_idx, i, j)[cell];
+            }
+        }
+        return invJ;
+    }
+    //=============================================================================
+    /// @brief Get the weight of a cell at each integration point, i.e. D * detJw
+    static void diffusion_weights(const Field &D, const CellGeometry &geometry,
+                                  int cell, std::span<real_t> wt)
+    {
+        const auto int_rule = geometry.element().integration_rule();
+        const int cell_idx = geometry.cells()[cell];
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            const real_t D_q = D.cell_qpt_value(cell_idx, *int_rule, qpt_idx);
+            wt[qpt_idx] = D_q * geometry.detJw(qpt_idx)[cell];
+        }
+    }
+    //=============================================================================
+    /// @brief Apply the diffusion operator of a cell to a scalar function using
+    /// sum factorization, i.e. y += K * u
+    /// @param wt Weight at each integration point, see diffusion_weights()
+    static void apply_diffusion_tp(const TensorProductBasis &basis,
+                                   const CellGeometry &geometry, int cell,
+                                   std::span<const real_t> wt,
+                                   std::span<const real_t> u,
+                                   std::span<real_t> y)
+    {
+        const int n_points = geometry.n_points();
+        const int dim = geometry.dim();
+
+        // Values and gradients (natural) at the integration points
+        std::array<real_t, TensorProductBasis::max_size> u_q;
+        std::array<real_t, 3 * TensorProductBasis::max_size> grad_q;
+        const std::span<real_t> grad(grad_q.data(), static_cast<std::size_t>(n_points * dim));
+        basis.interpolate(u, {u_q.data(), static_cast<std::size_t>(n_points)}, grad);
+
+        // Weighted gradient w.r.t. physical coordinates,
+        // mapped back to natural coordinates, i.e. wt * invJ * invJ^T * grad_xi
+        for (int qpt_idx = 0; qpt_idx < n_points; qpt_idx++)
+        {
+            const auto invJ = cell_invJ(geometry, cell, qpt_idx);
+            real_t *grad_xi = grad.data() + qpt_idx * dim;
+
+            std::array<real_t, 3> grad_X{};
+            for (int i = 0; i < dim; i++)
+            {
+                for (int j = 0; j < dim; j++)
+                {
+                    grad_X[i] += wt[qpt_idx] * grad_xi[j] * invJ[j][i];
+                }
+            }
+            for (int j = 0; j < dim; j++)
+            {
+                grad_xi[j] = 0.0;
+                for (int i = 0; i < dim; i++)
+                {
+                    grad_xi[j] += invJ[j][i] * grad_X[i];
+                }
+            }
+        }
+
+        basis.integrate({}, grad, y);
+    }
     //=============================================================================
     Diffusion::Diffusion(FEField phi, Field &D)
         : phi_(phi),
@@ -25,49 +104,248 @@ namespace sfem::fem
         return D_;
     }
     //=============================================================================
-    void Diffusion::operator()(la::MatSet lhs, la::VecSet rhs)
+    void Diffusion::operator()(CellMatSet lhs, la::VecSet rhs)
     {
         // Quick access
         const auto V = phi_.space();
 
+        // Per-thread element workspaces and batched cell geometry
+        auto workspaces = create_workspaces();
+        std::vector<CellGeometry> geometries(omp::n_threads());
+
         auto work = [&](const mesh::Mesh &,
-                        const mesh::Region &,
-                        const mesh::Cell &cell,
-                        int cell_idx)
+                        mesh::CellType cell_type,
+                        std::span<const int> cells)
         {
-            const auto element = V->element(cell.type);
-            const auto int_rule = element->integration_rule();
-            const int n_nodes = element->n_nodes();
-            const int dim = element->dim();
+            auto &ws = workspaces[omp::thread_id()];
+            const auto &data = ws.data;
 
-            const auto elem_dof = V->cell_dof(cell_idx);
-            const auto elem_pts = V->cell_dof_points(cell_idx);
+            auto &geometry = geometries[omp::thread_id()];
+            geometry.compute(*V, cell_type, cells);
+            const auto &element = geometry.element();
+            const int n_nodes = element.n_nodes();
+            const int dim = geometry.dim();
+            const auto basis = element.tensor_product_basis();
 
-            la::DenseMatrix K(element->n_nodes(), element->n_nodes());
-
-            for (int qpt_idx = 0; qpt_idx < int_rule->n_points(); qpt_idx++)
+            auto assemble = [&]<int NNodes, int Dim>(std::integral_constant<int, NNodes>,
+                                                     std::integral_constant<int, Dim>)
             {
-                const real_t qwt = int_rule->weight(qpt_idx);
-                const auto qpt = int_rule->point(qpt_idx);
-                const auto data = element->transform(cell_idx, dim, qpt, elem_pts);
-                const real_t Jwt = data.detJ * qwt;
-
-                const real_t D = D_.cell_value(cell_idx, qpt);
-                for (int i = 0; i < n_nodes; i++)
+                for (int c = 0; c < geometry.n_cells(); c++)
                 {
-                    for (int j = 0; j < n_nodes; j++)
+                    const int cell_idx = cells[c];
+                    const auto elem_dof = V->cell_dof(cell_idx);
+
+                    if constexpr (NNodes > 0)
+                    {
+                        // Linear elements: fixed-size element matrix
+                        la::StaticMatrix<NNodes, NNodes> K;
+
+                        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+                        {
+                            geometry.transform(c, qpt_idx, ws.data);
+                            const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                            const real_t D = D_.cell_value_at(data);
+                            const la::StaticMatrix<NNodes, Dim> dNdX(data.dNdX.values());
+                            la::add_BtB(la::transpose(dNdX), D * Jwt, K);
+                        }
+                        lhs(cell_idx, elem_dof, K.values());
+                    }
+                    else if (basis)
                     {
-                        real_t aij = 0.0;
-                        for (int dir = 0; dir < dim; dir++)
+                        // Tensor-product elements: assemble the element matrix column by column,
+                        // i.e. apply the (sum-factorized) operator to each unit vector
+                        auto &K = ws.matrix(0, n_nodes, n_nodes);
+                        std::array<real_t, TensorProductBasis::max_size> wt, e, col;
+                        diffusion_weights(D_, geometry, c, wt);
+                        std::fill_n(e.begin(), n_nodes, 0.0);
+
+                        for (int j = 0; j < n_nodes; j++)
                         {
-                            aij += data.dNdX(i, dir) * data.dNdX(j, dir);
+                            e[j] = 1.0;
+                            std::fill_n(col.begin(), n_nodes, 0.0);
+                            apply_diffusion_tp(*basis, geometry, c, wt,
+                                               {e.data(), static_cast<std::size_t>(n_nodes)},
+                                               {col.data(), static_cast<std::size_t>(n_nodes)});
+                            for (int i = 0; i < n_nodes; i++)
+                            {
+                                K(i, j) = col[i];
+                            }
+                            e[j] = 0.0;
                         }
-                        K(i, j) += D * aij * data.detJ * Jwt;
+                        lhs(cell_idx, elem_dof, K.values());
+                    }
+                    else
+                    {
+                        auto &K = ws.matrix(0, n_nodes, n_nodes);
+
+                        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+                        {
+                            geometry.transform(c, qpt_idx, ws.data);
+                            const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                            const real_t D = D_.cell_value_at(data);
+                            for (int i = 0; i < n_nodes; i++)
+                            {
+                                for (int j = 0; j < n_nodes; j++)
+                                {
+                                    real_t aij = 0.0;
+                                    for (int dir = 0; dir < dim; dir++)
+                                    {
+                                        aij += data.dNdX(i, dir) * data.dNdX(j, dir);
+                                    }
+                                    K(i, j) += D * aij * Jwt;
+                                }
+                            }
+                        }
+                        lhs(cell_idx, elem_dof, K.values());
                     }
                 }
-            }
-            lhs(elem_dof, elem_dof, K.values());
+            };
+            dispatch_element(cell_type, element.order(), assemble);
         };
-        mesh::utils::for_all_cells(*V->mesh(), work);
+        mesh::utils::for_all_cell_batches(*V->mesh(), work, V->cell_batches());
+    }
+    //=============================================================================
+    MatrixFreeDiffusion::MatrixFreeDiffusion(FEField phi, Field &D)
+        : MatrixFreeOperator(phi),
+          D_(D)
+    {
+    }
+    //=============================================================================
+    Field &MatrixFreeDiffusion::D()
+    {
+        return D_;
+    }
+    //=============================================================================
+    const Field &MatrixFreeDiffusion::D() const
+    {
+        return D_;
+    }
+    //=============================================================================
+    void MatrixFreeDiffusion::apply_cell(const CellGeometry &geometry, int cell,
+                                         std::span<const real_t> x,
+                                         std::span<real_t> y) const
+    {
+        // Quick access
+        const auto &element = geometry.element();
+        const auto int_rule = element.integration_rule();
+        const int n_nodes = element.n_nodes();
+        const int dim = geometry.dim();
+        const int n_comp = phi_.n_comp();
+        const int cell_idx = geometry.cells()[cell];
+
+        // Tensor-product elements: apply the operator to each component using sum factorization
+        if (const auto basis = element.tensor_product_basis())
+        {
+            std::array<real_t, TensorProductBasis::max_size> wt, u, v;
+            diffusion_weights(D_, geometry, cell, wt);
+            for (int k = 0; k < n_comp; k++)
+            {
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    u[a] = x[a * n_comp + k];
+                    v[a] = 0.0;
+                }
+                apply_diffusion_tp(*basis, geometry, cell, wt,
+                                   {u.data(), static_cast<std::size_t>(n_nodes)},
+                                   {v.data(), static_cast<std::size_t>(n_nodes)});
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    y[a * n_comp + k] += v[a];
+                }
+            }
+            return;
+        }
+
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            const auto dNdxi = geometry.shape_grad(qpt_idx);
+            const auto invJ = cell_invJ(geometry, cell, qpt_idx);
+
+            const real_t D = D_.cell_qpt_value(cell_idx, *int_rule, qpt_idx);
+            const real_t wt = D * geometry.detJw(qpt_idx)[cell];
+
+            for (int k = 0; k < n_comp; k++)
+            {
+                // Gradient w.r.t. natural coordinates
+                std::array<real_t, 3> grad_xi{};
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    for (int j = 0; j < dim; j++)
+                    {
+                        grad_xi[j] += x[a * n_comp + k] * dNdxi[a * dim + j];
+                    }
+                }
+
+                // Weighted gradient w.r.t. physical coordinates,
+                // mapped back to natural coordinates, i.e. wt * invJ * invJ^T * grad_xi
+                std::array<real_t, 3> grad_X{};
+                for (int i = 0; i < dim; i++)
+                {
+                    for (int j = 0; j < dim; j++)
+                    {
+                        grad_X[i] += wt * grad_xi[j] * invJ[j][i];
+                    }
+                }
+                std::array<real_t, 3> flux_xi{};
+                for (int j = 0; j < dim; j++)
+                {
+                    for (int i = 0; i < dim; i++)
+                    {
+                        flux_xi[j] += invJ[j][i] * grad_X[i];
+                    }
+                }
+
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    real_t sum = 0.0;
+                    for (int j = 0; j < dim; j++)
+                    {
+                        sum += dNdxi[a * dim + j] * flux_xi[j];
+                    }
+                    y[a * n_comp + k] += sum;
+                }
+            }
+        }
+    }
+    //=============================================================================
+    void MatrixFreeDiffusion::cell_diagonal(const CellGeometry &geometry, int cell,
+                                            std::span<real_t> d) const
+    {
+        // Quick access
+        const auto &element = geometry.element();
+        const auto int_rule = element.integration_rule();
+        const int n_nodes = element.n_nodes();
+        const int dim = geometry.dim();
+        const int n_comp = phi_.n_comp();
+        const int cell_idx = geometry.cells()[cell];
+
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            const auto dNdxi = geometry.shape_grad(qpt_idx);
+            const auto invJ = cell_invJ(geometry, cell, qpt_idx);
+
+            const real_t D = D_.cell_qpt_value(cell_idx, *int_rule, qpt_idx);
+            const real_t wt = D * geometry.detJw(qpt_idx)[cell];
+
+            for (int a = 0; a < n_nodes; a++)
+            {
+                real_t aii = 0.0;
+                for (int i = 0; i < dim; i++)
+                {
+                    real_t dNdX = 0.0;
+                    for (int j = 0; j < dim; j++)
+                    {
+                        dNdX += dNdxi[a * dim + j] * invJ[j][i];
+                    }
+                    aii += dNdX * dNdX;
+                }
+                for (int k = 0; k < n_comp; k++)
+                {
+                    d[a * n_comp + k] += wt * aii;
+                }
+            }
+        }
     }
 }
\ No newline at end of file
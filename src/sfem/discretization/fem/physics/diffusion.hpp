@@ -2,6 +2,8 @@
 
 #include <sfem/discretization/fem/core/elements/fe.hpp>
 #include <sfem/discretization/fem/core/fe_field.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
+#include <sfem/discretization/fem/core/matrix_free_operator.hpp>
 
 namespace sfem::fem
 {
@@ -15,10 +17,32 @@ namespace sfem::fem
         Field &D();
         const Field &D() const;
 
-        void operator()(la::MatSet lhs, la::VecSet rhs);
+        void operator()(CellMatSet lhs, la::VecSet rhs);
 
     private:
         FEField phi_;
         Field &D_;
     };
+
+    /// @brief Matrix-free operator of the Diffusion kernel,
+    /// applied to each component of the field independently
+    class MatrixFreeDiffusion : public MatrixFreeOperator
+    {
+    public:
+        MatrixFreeDiffusion(FEField phi, Field &D);
+
+        Field &D();
+        const Field &D() const;
+
+    protected:
+        void apply_cell(const CellGeometry &geometry, int cell,
+                        std::span<const real_t> x,
+                        std::span<real_t> y) const override;
+
+        void cell_diagonal(const CellGeometry &geometry, int cell,
+                           std::span<real_t> d) const override;
+
+    private:
+        Field &D_;
+    };
 }
\ No newline at end of file
@@ -1,8 +1,41 @@
 #include "mass.hpp"
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
+#include <sfem/discretization/fem/core/elements/tensor_product.hpp>
 #include <sfem/mesh/utils/loop_utils.hpp>
+#include <sfem/parallel/omp.hpp>
 
 namespace sfem::fem
 {
+    //=============================================================================
+    /// @brief Get the weight of a cell at each integration point, i.e. C * detJw
+    static void mass_weights(const Field &C, const CellGeometry &geometry,
+                             int cell, std::span<real_t> wt)
+    {
+        const auto int_rule = geometry.element().integration_rule();
+        const int cell_idx = geometry.cells()[cell];
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            wt[qpt_idx] = C.cell_qpt_value(cell_idx, *int_rule, qpt_idx) * geometry.detJw(qpt_idx)[cell];
+        }
+    }
+    //=============================================================================
+    /// @brief Apply the mass operator of a cell to a scalar function using
+    /// sum factorization, i.e. y += M * u
+    /// @param wt Weight at each integration point, see mass_weights()
+    static void apply_mass_tp(const TensorProductBasis &basis,
+                              std::span<const real_t> wt,
+                              std::span<const real_t> u,
+                              std::span<real_t> y)
+    {
+        std::array<real_t, TensorProductBasis::max_size> u_q;
+        const std::span<real_t> values(u_q.data(), wt.size());
+        basis.interpolate(u, values, {});
+        for (std::size_t q = 0; q < wt.size(); q++)
+        {
+            values[q] *= wt[q];
+        }
+        basis.integrate(values, {}, y);
+    }
     //=============================================================================
     MassND::MassND(FEField phi, Field &C)
         : phi_(phi),
@@ -10,49 +43,171 @@ namespace sfem::fem
     {
     }
     //=============================================================================
-    void MassND::operator()(la::MatSet lhs, la::VecSet)
+    void MassND::operator()(CellMatSet lhs, la::VecSet)
     {
         // Quick access
         const auto V = phi_.space();
         const int n_comp = phi_.n_comp();
 
+        // Per-thread element workspaces and batched cell geometry
+        auto workspaces = create_workspaces();
+        std::vector<CellGeometry> geometries(omp::n_threads());
+
         auto work = [&](const mesh::Mesh &,
-                        const mesh::Region &,
-                        const mesh::Cell &cell,
-                        int cell_idx)
+                        mesh::CellType cell_type,
+                        std::span<const int> cells)
         {
-            const auto element = V->element(cell.type);
-            const auto int_rule = element->integration_rule();
-            const int n_nodes = element->n_nodes();
-            const int dim = element->dim();
-
-            const auto elem_dof = V->cell_dof(cell_idx);
-            const auto elem_pts = V->cell_dof_points(cell_idx);
+            auto &ws = workspaces[omp::thread_id()];
+            const auto &data = ws.data;
 
-            // Element mass matrix
-            la::DenseMatrix M(n_nodes * n_comp, n_nodes * n_comp);
+            auto &geometry = geometries[omp::thread_id()];
+            geometry.compute(*V, cell_type, cells);
+            const int n_nodes = geometry.element().n_nodes();
+            const int n_points = geometry.n_points();
+            const auto basis = geometry.element().tensor_product_basis();
 
-            for (int qpt_idx = 0; qpt_idx < int_rule->n_points(); qpt_idx++)
+            for (int c = 0; c < geometry.n_cells(); c++)
             {
-                const real_t qwt = int_rule->weight(qpt_idx);
-                const auto qpt = int_rule->point(qpt_idx);
-                const auto data = element->transform(cell_idx, dim, qpt, elem_pts);
-                const real_t Jwt = data.detJ * qwt;
+                const int cell_idx = cells[c];
+                const auto elem_dof = V->cell_dof(cell_idx);
 
-                const real_t C = C_.cell_value(cell_idx, qpt);
-                for (int i = 0; i < n_nodes; i++)
+                // Element mass matrix
+                auto &M = ws.matrix(0, n_nodes * n_comp, n_nodes * n_comp);
+
+                // Tensor-product elements: compute the (scalar) element matrix column by column,
+                // i.e. apply the (sum-factorized) operator to each unit vector
+                if (basis)
                 {
+                    std::array<real_t, TensorProductBasis::max_size> wt, e, col;
+                    mass_weights(C_, geometry, c, {wt.data(), static_cast<std::size_t>(n_points)});
+                    std::fill_n(e.begin(), n_nodes, 0.0);
+
                     for (int j = 0; j < n_nodes; j++)
                     {
-                        for (int k = 0; k < n_comp; k++)
+                        e[j] = 1.0;
+                        std::fill_n(col.begin(), n_nodes, 0.0);
+                        apply_mass_tp(*basis, {wt.data(), static_cast<std::size_t>(n_points)},
+                                      {e.data(), static_cast<std::size_t>(n_nodes)},
+                                      {col.data(), static_cast<std::size_t>(n_nodes)});
+                        for (int i = 0; i < n_nodes; i++)
                         {
-                            M(i * n_comp + k, j * n_comp + k) += C * data.N(i, 0) * data.N(j, 0) * Jwt;
+                            for (int k = 0; k < n_comp; k++)
+                            {
+                                M(i * n_comp + k, j * n_comp + k) = col[i];
+                            }
                         }
+                        e[j] = 0.0;
                     }
+                    lhs(cell_idx, elem_dof, M.values());
+                    continue;
                 }
+
+                for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+                {
+                    geometry.transform(c, qpt_idx, ws.data);
+                    const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                    const real_t C = C_.cell_value_at(data);
+                    for (int i = 0; i < n_nodes; i++)
+                    {
+                        for (int j = 0; j < n_nodes; j++)
+                        {
+                            for (int k = 0; k < n_comp; k++)
+                            {
+                                M(i * n_comp + k, j * n_comp + k) += C * data.N(i, 0) * data.N(j, 0) * Jwt;
+                            }
+                        }
+                    }
+                }
+                lhs(cell_idx, elem_dof, M.values());
             }
-            lhs(elem_dof, elem_dof, M.values());
         };
-        mesh::utils::for_all_cells(*V->mesh(), work);
+        mesh::utils::for_all_cell_batches(*V->mesh(), work, V->cell_batches());
+    }
+    //=============================================================================
+    MatrixFreeMass::MatrixFreeMass(FEField phi, Field &C)
+        : MatrixFreeOperator(phi),
+          C_(C)
+    {
+    }
+    //=============================================================================
+    void MatrixFreeMass::apply_cell(const CellGeometry &geometry, int cell,
+                                    std::span<const real_t> x,
+                                    std::span<real_t> y) const
+    {
+        // Quick access
+        const auto int_rule = geometry.element().integration_rule();
+        const int n_nodes = geometry.element().n_nodes();
+        const int n_comp = phi_.n_comp();
+        const int cell_idx = geometry.cells()[cell];
+
+        // Tensor-product elements: apply the operator to each component using sum factorization
+        if (const auto basis = geometry.element().tensor_product_basis())
+        {
+            std::array<real_t, TensorProductBasis::max_size> wt, u, v;
+            const std::span<const real_t> wt_span(wt.data(), static_cast<std::size_t>(geometry.n_points()));
+            mass_weights(C_, geometry, cell, wt);
+            for (int k = 0; k < n_comp; k++)
+            {
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    u[a] = x[a * n_comp + k];
+                    v[a] = 0.0;
+                }
+                apply_mass_tp(*basis, wt_span,
+                              {u.data(), static_cast<std::size_t>(n_nodes)},
+                              {v.data(), static_cast<std::size_t>(n_nodes)});
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    y[a * n_comp + k] += v[a];
+                }
+            }
+            return;
+        }
+
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            const auto N = geometry.shape(qpt_idx);
+            const real_t C = C_.cell_qpt_value(cell_idx, *int_rule, qpt_idx);
+            const real_t wt = C * geometry.detJw(qpt_idx)[cell];
+
+            for (int k = 0; k < n_comp; k++)
+            {
+                real_t u = 0.0;
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    u += N[a] * x[a * n_comp + k];
+                }
+                for (int a = 0; a < n_nodes; a++)
+                {
+                    y[a * n_comp + k] += wt * N[a] * u;
+                }
+            }
+        }
+    }
+    //=============================================================================
+    void MatrixFreeMass::cell_diagonal(const CellGeometry &geometry, int cell,
+                                       std::span<real_t> d) const
+    {
+        // Quick access
+        const auto int_rule = geometry.element().integration_rule();
+        const int n_nodes = geometry.element().n_nodes();
+        const int n_comp = phi_.n_comp();
+        const int cell_idx = geometry.cells()[cell];
+
+        for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+        {
+            const auto N = geometry.shape(qpt_idx);
+            const real_t C = C_.cell_qpt_value(cell_idx, *int_rule, qpt_idx);
+            const real_t wt = C * geometry.detJw(qpt_idx)[cell];
+
+            for (int a = 0; a < n_nodes; a++)
+            {
+                for (int k = 0; k < n_comp; k++)
+                {
+                    d[a * n_comp + k] += wt * N[a] * N[a];
+                }
+            }
+        }
     }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <sfem/discretization/fem/core/elements/fe.hpp>
 #include <sfem/discretization/fem/core/fe_field.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
+#include <sfem/discretization/fem/core/matrix_free_operator.hpp>
 
 namespace sfem::fem
 {
@@ -10,10 +12,28 @@ namespace sfem::fem
     public:
         MassND(FEField phi, Field &C);
 
-        void operator()(la::MatSet lhs, la::VecSet rhs);
+        void operator()(CellMatSet lhs, la::VecSet rhs);
 
     private:
         FEField phi_;
         Field &C_;
     };
+
+    /// @brief Matrix-free operator of the MassND kernel
+    class MatrixFreeMass : public MatrixFreeOperator
+    {
+    public:
+        MatrixFreeMass(FEField phi, Field &C);
+
+    protected:
+        void apply_cell(const CellGeometry &geometry, int cell,
+                        std::span<const real_t> x,
+                        std::span<real_t> y) const override;
+
+        void cell_diagonal(const CellGeometry &geometry, int cell,
+                           std::span<real_t> d) const override;
+
+    private:
+        Field &C_;
+    };
 }
\ No newline at end of file
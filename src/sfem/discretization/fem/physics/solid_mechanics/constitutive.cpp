@@ -59,8 +59,8 @@ namespace sfem::fem::solid_mechanics
                                            const la::DenseMatrix &,
                                            la::DenseMatrix &D) const
     {
-        const real_t E = E_.cell_value(data.elem_idx, data.pt);
-        const real_t nu = nu_.cell_value(data.elem_idx, data.pt);
+        const real_t E = E_.cell_value_at(data);
+        const real_t nu = nu_.cell_value_at(data);
         const real_t c = E / (1 - nu * nu);
         D(0, 0) = c * 1.0;
         D(0, 1) = c * nu;
@@ -97,8 +97,8 @@ namespace sfem::fem::solid_mechanics
                                   const la::DenseMatrix &,
                                   la::DenseMatrix &D) const
     {
-        const real_t E = E_.cell_value(data.elem_idx, data.pt);
-        const real_t nu = nu_.cell_value(data.elem_idx, data.pt);
+        const real_t E = E_.cell_value_at(data);
+        const real_t nu = nu_.cell_value_at(data);
         const real_t c1 = E / ((1 + nu) * (1 - 2 * nu));
         const real_t c2 = (1 - 2 * nu) / 2;
         D(0, 0) = (1 - nu) * c1;
@@ -1,6 +1,11 @@
 #include "linear_elasticity.hpp"
+#include <sfem/discretization/fem/core/cell_geometry.hpp>
+#include <sfem/discretization/fem/core/elements/element_dispatch.hpp>
+#include <sfem/la/native/static_matrix.hpp>
 #include <sfem/mesh/utils/loop_utils.hpp>
 #include <sfem/mesh/utils/geo_utils.hpp>
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/parallel/omp.hpp>
 
 namespace sfem::fem::solid_mechanics
 {
@@ -20,7 +25,7 @@ namespace sfem::fem::solid_mechanics
         }
     }
     //=============================================================================
-    void LinearElasticity::operator()(la::MatSet lhs, la::VecSet rhs)
+    void LinearElasticity::operator()(CellMatSet lhs, la::VecSet rhs)
     {
         // Quick access
         const auto V = U_.space();
@@ -28,76 +33,136 @@ namespace sfem::fem::solid_mechanics
         const int dim = constitutive_.dim();
         const int n_strain = constitutive_.n_strain();
 
-        /// @todo The element matrices could be defined
-        /// once here, and resized if nencessary, to
-        /// reduce memory allocations
+        // Per-thread element workspaces and batched cell geometry
+        auto workspaces = create_workspaces();
+        std::vector<CellGeometry> geometries(omp::n_threads());
 
         auto work = [&](const mesh::Mesh &,
-                        const mesh::Region &,
-                        const mesh::Cell &cell,
-                        int cell_idx)
+                        mesh::CellType cell_type,
+                        std::span<const int> cells)
         {
-            const auto element = V->element(cell.type);
-            const auto int_rule = element->integration_rule();
-            const int n_nodes = element->n_nodes();
-            const int n_dof = n_nodes * dim;
-
-            const auto elem_dof = V->cell_dof(cell_idx);
-            const auto elem_pts = V->cell_dof_points(cell_idx);
-
-            // Element displacement vector
-            // la::DenseMatrix u(n_dof, 1);
-
-            // Strain vector
-            la::DenseMatrix e(n_strain, 1);
+            auto &ws = workspaces[omp::thread_id()];
+            const auto &data = ws.data;
 
-            // Stress vector
-            // la::DenseMatrix s(n_strain, 1);
+            auto &geometry = geometries[omp::thread_id()];
+            geometry.compute(*V, cell_type, cells);
+            const auto &element = geometry.element();
+            const int n_nodes = element.n_nodes();
+            const int n_dof = n_nodes * dim;
 
-            // Element strain-displacement matrix
-            la::DenseMatrix B(n_strain, n_dof);
+            auto assemble = [&]<int NNodes, int Dim>(std::integral_constant<int, NNodes>,
+                                                     std::integral_constant<int, Dim>)
+            {
+                for (int c = 0; c < geometry.n_cells(); c++)
+                {
+                    const int cell_idx = cells[c];
+                    const auto elem_dof = V->cell_dof(cell_idx);
 
-            // Element stress-strain matrix
-            la::DenseMatrix D(n_strain, n_strain);
+                    // Strain vector
+                    auto &e = ws.matrix(0, n_strain, 1);
 
-            // Element stiffness matrix
-            la::DenseMatrix K(n_dof, n_dof);
+                    // Element strain-displacement matrix
+                    auto &B = ws.matrix(1, n_strain, n_dof);
 
-            // Element force vector
-            la::DenseMatrix F(n_dof, 1);
+                    // Element stress-strain matrix
+                    auto &D = ws.matrix(2, n_strain, n_strain);
 
-            for (int qpt_idx = 0; qpt_idx < int_rule->n_points(); qpt_idx++)
-            {
-                const real_t qwt = int_rule->weight(qpt_idx);
-                const auto qpt = int_rule->point(qpt_idx);
-                const auto data = element->transform(cell_idx, dim, qpt, elem_pts);
-                const real_t Jwt = data.detJ * qwt;
+                    // Linear elements: fixed-size element matrices
+                    constexpr int NStrain = Dim == 2 ? 3 : 6;
+                    if constexpr (NNodes > 0)
+                    {
+                        if (Dim == dim and NStrain == n_strain)
+                        {
+                            la::StaticMatrix<NNodes * Dim, NNodes * Dim> K;
+                            la::StaticMatrix<NNodes * Dim, 1> F;
+
+                            for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
+                            {
+                                geometry.transform(c, qpt_idx, ws.data);
+                                const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                                strain_.B_mat(data, B);
+
+                                constitutive_.tangent(data, e, D);
+
+                                la::add_BtDB(la::StaticMatrix<NStrain, NNodes * Dim>(B.values()),
+                                             la::StaticMatrix<NStrain, NStrain>(D.values()),
+                                             Jwt, K);
+
+                                const real_t rho = rho_.cell_value_at(data);
+                                for (int i = 0; i < NNodes; i++)
+                                {
+                                    // Inertial force
+                                    for (int dir = 0; dir < Dim; dir++)
+                                    {
+                                        F(i * Dim + dir, 0) += rho * g_[dir] * data.N(i, 0) * Jwt;
+                                    }
+                                }
+                            }
+
+                            lhs(cell_idx, elem_dof, K.values());
+                            if (rhs)
+                            {
+                                rhs(elem_dof, F.values());
+                            }
+                            continue;
+                        }
+                    }
 
-                strain_.B_mat(data, B);
+                    // Product of the stress-strain and strain-displacement matrices
+                    auto &DB = ws.matrix(3, n_strain, n_dof);
 
-                constitutive_.tangent(data, e, D);
+                    // Element stiffness matrix
+                    auto &K = ws.matrix(4, n_dof, n_dof);
 
-                K += B.T() * D * B * Jwt;
+                    // Element force vector
+                    auto &F = ws.matrix(5, n_dof, 1);
 
-                const real_t rho = rho_.cell_value(cell_idx, qpt);
-                for (int i = 0; i < n_nodes; i++)
-                {
-                    // Inertial force
-                    for (int dir = 0; dir < dim; dir++)
+                    for (int qpt_idx = 0; qpt_idx < geometry.n_points(); qpt_idx++)
                     {
-                        F(i * dim + dir, 0) += rho * g_[dir] * data.N(i, 0) * Jwt;
+                        geometry.transform(c, qpt_idx, ws.data);
+                        const real_t Jwt = geometry.detJw(qpt_idx)[c];
+
+                        strain_.B_mat(data, B);
+
+                        constitutive_.tangent(data, e, D);
+
+                        // K += B^T * D * B * Jwt
+                        la::utils::matmult(n_strain, n_dof, n_strain, D.values(), B.values(), DB.values());
+                        for (int k = 0; k < n_strain; k++)
+                        {
+                            for (int i = 0; i < n_dof; i++)
+                            {
+                                const real_t Bki = B(k, i) * Jwt;
+                                for (int j = 0; j < n_dof; j++)
+                                {
+                                    K(i, j) += Bki * DB(k, j);
+                                }
+                            }
+                        }
+
+                        const real_t rho = rho_.cell_value_at(data);
+                        for (int i = 0; i < n_nodes; i++)
+                        {
+                            // Inertial force
+                            for (int dir = 0; dir < dim; dir++)
+                            {
+                                F(i * dim + dir, 0) += rho * g_[dir] * data.N(i, 0) * Jwt;
+                            }
+
+                            /// @todo Add user-defined force terms here
+                        }
                     }
 
-                    /// @todo Add user-defined force terms here
+                    lhs(cell_idx, elem_dof, K.values());
+                    if (rhs)
+                    {
+                        rhs(elem_dof, F.values());
+                    }
                 }
-            }
-
-            lhs(elem_dof, elem_dof, K.values());
-            if (rhs)
-            {
-                rhs(elem_dof, F.values());
-            }
+            };
+            dispatch_element(cell_type, element.order(), assemble);
         };
-        mesh::utils::for_all_cells(*V->mesh(), work);
+        mesh::utils::for_all_cell_batches(*V->mesh(), work, V->cell_batches());
     }
 }
\ No newline at end of file
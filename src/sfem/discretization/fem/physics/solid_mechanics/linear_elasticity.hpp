@@ -2,6 +2,7 @@
 
 #include <sfem/discretization/fem/physics/solid_mechanics/constitutive.hpp>
 #include <sfem/discretization/fem/physics/solid_mechanics/strain.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
 
 namespace sfem::fem::solid_mechanics
 {
@@ -12,7 +13,7 @@ namespace sfem::fem::solid_mechanics
                          LinearElasticIsotropic &constitutive,
                          const std::array<real_t, 3> &g = {});
 
-        void operator()(la::MatSet lhs, la::VecSet rhs);
+        void operator()(CellMatSet lhs, la::VecSet rhs);
 
     private:
         FEField U_;
@@ -22,7 +22,7 @@ namespace sfem::fem::solid_mechanics
         return P_;
     }
     //=============================================================================
-    void PressureLoad::operator()(la::MatSet, la::VecSet rhs)
+    void PressureLoad::operator()(CellMatSet, la::VecSet rhs)
     {
         // Quick access
         const auto V = U_.space();
@@ -47,7 +47,7 @@ namespace sfem::fem::solid_mechanics
             {
                 const real_t qwt = int_rule->weight(qpt_idx);
                 const auto qpt = int_rule->point(qpt_idx);
-                const auto data = element->transform(facet_idx, dim, qpt, elem_pts);
+                const auto data = element->transform(facet_idx, dim, qpt_idx, elem_pts);
                 const real_t Jwt = data.detJ * qwt;
 
                 const real_t pressure = P_.facet_value(facet_idx, qpt);
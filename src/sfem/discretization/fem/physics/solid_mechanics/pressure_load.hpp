@@ -2,6 +2,7 @@
 
 #include <sfem/discretization/fem/core/elements/fe.hpp>
 #include <sfem/discretization/fem/core/fe_field.hpp>
+#include <sfem/discretization/fem/core/cell_matset.hpp>
 
 namespace sfem::fem::solid_mechanics
 {
@@ -13,7 +14,7 @@ namespace sfem::fem::solid_mechanics
         Field &P();
         const Field &P() const;
 
-        void operator()(la::MatSet lhs, la::VecSet rhs);
+        void operator()(CellMatSet lhs, la::VecSet rhs);
 
     private:
         FEField U_;
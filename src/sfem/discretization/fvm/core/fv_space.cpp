@@ -1,6 +1,7 @@
 #include "fv_space.hpp"
 #include <sfem/discretization/fem/core/cg_space.hpp>
 #include <sfem/mesh/utils/geo_utils.hpp>
+#include <sfem/graph/coloring.hpp>
 #include <sfem/geo/utils.hpp>
 
 namespace sfem::fvm
@@ -21,7 +22,7 @@ namespace sfem::fvm
         // The cell-to-cell conn. in topology is computed from the cell-to-node conn.
         // For the finite volume method, two cells are adjacent not when they share
         // a node, but a facet. Thus, the DoF-to-DoF connectivity is defined as follows
-        connectivity_ = std::make_shared<graph::Connectivity>(cell_to_facet->primary_to_primary(1, true));
+        connectivity_ = std::make_shared<graph::Connectivity>(cell_to_facet->primary_to_primary(1, true, true));
 
         // The cell index map in topology is not renumbered, i.e. the global indices of
         // the owned cells are not contiguous. Thus, the DoF index map is defined as
@@ -42,10 +43,7 @@ namespace sfem::fvm
             cell_midpoints_[i] = mesh::cell_midpoint(cell_points);
             for (int nqpt = 0; nqpt < element->integration_rule()->n_points(); nqpt++)
             {
-                cell_volumes_[i] += element->transform(i, dim,
-                                                       element->integration_rule()->point(nqpt),
-                                                       cell_points)
-                                        .detJ;
+                cell_volumes_[i] += element->transform(i, dim, nqpt, cell_points).detJ;
             }
         }
 
@@ -84,6 +82,24 @@ namespace sfem::fvm
 
             facet_interp_factor_[i] = facet_cell_distances_[i][1] / facet_intercell_distances_[i].mag();
         }
+
+        // Facet coloring, so that facets of the same color
+        // can be assembled concurrently
+        std::vector<int> facet_cell_offsets(n_facets + 1, 0);
+        std::vector<int> facet_cell_array;
+        facet_cell_array.reserve(2 * n_facets);
+        for (int i = 0; i < n_facets; i++)
+        {
+            const auto &[owner, neighbour] = facet_adjacent_cells_[i];
+            facet_cell_array.push_back(owner);
+            if (neighbour != owner)
+            {
+                facet_cell_array.push_back(neighbour);
+            }
+            facet_cell_offsets[i + 1] = static_cast<int>(facet_cell_array.size());
+        }
+        facet_colors_ = graph::greedy_coloring(graph::Connectivity(std::move(facet_cell_offsets),
+                                                                   std::move(facet_cell_array)));
     }
     //=============================================================================
     std::shared_ptr<const mesh::Mesh> FVSpace::mesh() const
@@ -165,4 +181,9 @@ namespace sfem::fvm
         return {delta, kappa};
     }
 
+    //=============================================================================
+    const graph::Connectivity &FVSpace::facet_colors() const
+    {
+        return facet_colors_;
+    }
 }
\ No newline at end of file
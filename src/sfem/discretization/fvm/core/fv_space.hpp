@@ -57,6 +57,10 @@ namespace sfem::fvm
         /// @brief Decompose a facet's area vector into the orthogonal and nonorthogonal parts
         std::array<geo::Vec3, 2> decompose_area_vec(int facet_idx) const;
 
+        /// @brief Get a coloring of the facets, such that no two facets of
+        /// the same color share an adjacent cell (color-to-facet connectivity)
+        const graph::Connectivity &facet_colors() const;
+
     private:
         /// @brief The mesh
         std::shared_ptr<const mesh::Mesh> mesh_;
@@ -94,5 +98,8 @@ namespace sfem::fvm
         /// of the non-owner cell and the facet midpoint, over the
         /// distance of the two adjacent cell midpoints
         std::vector<real_t> facet_interp_factor_;
+
+        /// @brief Color-to-facet connectivity
+        graph::Connectivity facet_colors_;
     };
 }
\ No newline at end of file
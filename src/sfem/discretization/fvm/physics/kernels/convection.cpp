@@ -103,6 +103,6 @@ namespace sfem::fvm
                 lhs(adjacent_cells, adjacent_cells, lhs_values);
             }
         };
-        mesh::utils::for_all_facets(*V->mesh(), work);
+        mesh::utils::for_all_facets(*V->mesh(), work, V->facet_colors());
     }
 }
\ No newline at end of file
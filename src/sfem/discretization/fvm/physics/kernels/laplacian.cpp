@@ -112,6 +112,6 @@ namespace sfem::fvm
                 }
             }
         };
-        mesh::utils::for_all_facets(*V->mesh(), work);
+        mesh::utils::for_all_facets(*V->mesh(), work, V->facet_colors());
     }
 }
\ No newline at end of file
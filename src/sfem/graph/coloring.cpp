@@ -0,0 +1,116 @@
+#include "coloring.hpp"
+#include <sfem/base/error.hpp>
+#include <numeric>
+#include <format>
+
+namespace sfem::graph
+{
+    //=============================================================================
+    /// @brief Group the entities by color
+    /// @param colors Color of each entity
+    /// @param n_colors Number of colors
+    /// @return Color-to-entity connectivity
+    static Connectivity group_by_color(const std::vector<int> &colors, int n_colors)
+    {
+        const int n = static_cast<int>(colors.size());
+        std::vector<int> offsets(n_colors + 1, 0);
+        for (int c : colors)
+        {
+            offsets[c + 1]++;
+        }
+        std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+
+        std::vector<int> array(n);
+        std::vector<int> pos(offsets.cbegin(), offsets.cend() - 1);
+        for (int i = 0; i < n; i++)
+        {
+            array[pos[colors[i]]++] = i;
+        }
+
+        return Connectivity(std::move(offsets), std::move(array));
+    }
+    //=============================================================================
+    /// @brief Get the smallest color that is not forbidden for entity i
+    /// (i.e. forbidden[color] != i), adding a color if required
+    static int smallest_available_color(std::vector<int> &forbidden, int i)
+    {
+        int color = 0;
+        while (color < static_cast<int>(forbidden.size()) and forbidden[color] == i)
+        {
+            color++;
+        }
+        if (color == static_cast<int>(forbidden.size()))
+        {
+            forbidden.push_back(-1);
+        }
+        return color;
+    }
+    //=============================================================================
+    Connectivity greedy_coloring(const Connectivity &conn)
+    {
+        const int n_primary = conn.n_primary();
+        const auto secondary_to_primary = conn.invert();
+
+        // Color of each primary (-1 if not yet colored), and the last
+        // primary for which each color was found to be unavailable
+        std::vector<int> colors(n_primary, -1);
+        std::vector<int> forbidden;
+        for (int i = 0; i < n_primary; i++)
+        {
+            for (int s : conn.links(i))
+            {
+                for (int j : secondary_to_primary.links(s))
+                {
+                    if (colors[j] >= 0)
+                    {
+                        forbidden[colors[j]] = i;
+                    }
+                }
+            }
+
+            colors[i] = smallest_available_color(forbidden, i);
+        }
+
+        return group_by_color(colors, static_cast<int>(forbidden.size()));
+    }
+    //=============================================================================
+    Connectivity greedy_graph_coloring(const Connectivity &adjacency)
+    {
+        const int n_vertices = adjacency.n_primary();
+        if (adjacency.n_secondary() > n_vertices)
+        {
+            SFEM_ERROR(std::format("Invalid adjacency: {} vertices are linked to {} vertices\n",
+                                   n_vertices, adjacency.n_secondary()));
+        }
+        const auto inverse = adjacency.invert();
+
+        // Color of each vertex (-1 if not yet colored), and the last
+        // vertex for which each color was found to be unavailable
+        std::vector<int> colors(n_vertices, -1);
+        std::vector<int> forbidden;
+        for (int i = 0; i < n_vertices; i++)
+        {
+            for (int j : adjacency.links(i))
+            {
+                if (j != i and colors[j] >= 0)
+                {
+                    forbidden[colors[j]] = i;
+                }
+            }
+            if (i < inverse.n_primary())
+            {
+                for (int j : inverse.links(i))
+                {
+                    if (j != i and colors[j] >= 0)
+                    {
+                        forbidden[colors[j]] = i;
+                    }
+                }
+            }
+
+            colors[i] = smallest_available_color(forbidden, i);
+        }
+
+        return group_by_color(colors, static_cast<int>(forbidden.size()));
+    }
+}
\ No newline at end of file
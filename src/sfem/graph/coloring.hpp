@@ -0,0 +1,23 @@
+#pragma once
+
+#include <sfem/graph/connectivity.hpp>
+
+namespace sfem::graph
+{
+    /// @brief Color the primaries of a connectivity, so that no two primaries
+    /// of the same color share a secondary, e.g. so that no two cells of the same
+    /// color share a DoF. Primaries are visited in order, and each is assigned the
+    /// smallest color not used by any primary it shares a secondary with
+    /// @param conn Primary-to-secondary connectivity
+    /// @return Color-to-primary connectivity, with the primaries of each color in ascending order
+    Connectivity greedy_coloring(const Connectivity &conn);
+
+    /// @brief Color the vertices of a graph, so that no two adjacent vertices have the
+    /// same color (distance-1 coloring), e.g. so that no two rows of the same color of a
+    /// sparse matrix are coupled. Vertices are visited in order, and each is assigned the
+    /// smallest color not used by any adjacent vertex
+    /// @param adjacency Vertex-to-vertex connectivity, where vertices i and j are adjacent
+    /// if j is a link of i or i is a link of j (self-links are ignored)
+    /// @return Color-to-vertex connectivity, with the vertices of each color in ascending order
+    Connectivity greedy_graph_coloring(const Connectivity &adjacency);
+}
\ No newline at end of file
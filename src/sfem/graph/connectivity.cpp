@@ -10,7 +10,8 @@ namespace sfem::graph
     Connectivity::Connectivity(std::vector<int> &&offsets, std::vector<int> &&array)
         : offsets_(std::move(offsets)),
           array_(std::move(array)),
-          n_secondary_(0)
+          n_secondary_(0),
+          sorted_(true)
     {
         SFEM_CHECK_SIZES(offsets_.back(), array_.size());
 
@@ -40,6 +41,13 @@ namespace sfem::graph
         {
             SFEM_ERROR(std::format("Invalid connectivity array\n"));
         }
+
+        // Check whether the links of each primary are sorted
+        for (int i = 0; i < n_primary() and sorted_; i++)
+        {
+            auto links_ = links(i);
+            sorted_ = std::is_sorted(links_.begin(), links_.end());
+        }
     }
     //=============================================================================
     std::vector<int> Connectivity::offsets() const
@@ -87,10 +95,9 @@ namespace sfem::graph
     int Connectivity::relative_index(int primary, int secondary) const
     {
         auto links_ = links(primary);
-        auto it = std::find(links_.cbegin(),
-                            links_.cend(),
-                            secondary);
-        if (it == links_.end())
+        auto it = sorted_ ? std::lower_bound(links_.begin(), links_.end(), secondary)
+                          : std::find(links_.begin(), links_.end(), secondary);
+        if (it == links_.end() or *it != secondary)
         {
             SFEM_ERROR(std::format("{} is not a link of {}\n", secondary, primary));
             return -1;
@@ -98,6 +105,20 @@ namespace sfem::graph
         return static_cast<int>(std::distance(links_.begin(), it));
     }
     //=============================================================================
+    bool Connectivity::is_sorted() const
+    {
+        return sorted_;
+    }
+    //=============================================================================
+    void Connectivity::sort()
+    {
+        for (int i = 0; i < n_primary(); i++)
+        {
+            std::sort(array_.begin() + offsets_[i], array_.begin() + offsets_[i + 1]);
+        }
+        sorted_ = true;
+    }
+    //=============================================================================
     Connectivity Connectivity::invert() const
     {
         // Compute the inverse connectivity offsets
@@ -127,7 +148,8 @@ namespace sfem::graph
     }
     //=============================================================================
     Connectivity Connectivity::primary_to_primary(int n_common,
-                                                  bool include_self) const
+                                                  bool include_self,
+                                                  bool sort) const
     {
         Timer timer;
 
@@ -223,6 +245,16 @@ namespace sfem::graph
         // Second loop, fill ptp connectivity array
         create_conn(false);
 
+        // Sort the links of each primary
+        if (sort)
+        {
+            for (int i = 0; i < n_primary(); i++)
+            {
+                std::sort(ptp_array.begin() + ptp_offsets[i],
+                          ptp_array.begin() + ptp_offsets[i + 1]);
+            }
+        }
+
         return Connectivity(std::move(ptp_offsets),
                             std::move(ptp_array));
     }
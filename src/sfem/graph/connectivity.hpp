@@ -64,17 +64,26 @@ namespace sfem::graph
         /// the perspective of a primary. For example, consider
         /// that the links of 5 are 10, 11, 12, 13.
         /// Then the relative index of 12 in 5 is 2
+        /// @note Uses binary search if the links are sorted
         int relative_index(int primary, int secondary) const;
 
+        /// @brief Whether the links of each primary are sorted in ascending order
+        bool is_sorted() const;
+
+        /// @brief Sort the links of each primary in ascending order
+        void sort();
+
         /// @brief Compute the inverse connectivity
         Connectivity invert() const;
 
         /// @brief Compute the connectivity between primaries
         /// @param n_common Number of required common secondaries
         /// for two primaries to be considered linked
+        /// @param include_self Whether each primary is linked to itself
+        /// @param sort Whether to sort the links of each primary
         /// @note n_common must be greater than 0, else an empty
         /// Connectivity is returned
-        Connectivity primary_to_primary(int n_common = 1, bool include_self = false) const;
+        Connectivity primary_to_primary(int n_common = 1, bool include_self = false, bool sort = false) const;
 
         /// @brief Get a string representation of the connectivity
         std::string str(std::string_view name = "Connectivity") const;
@@ -88,5 +97,8 @@ namespace sfem::graph
 
         /// @brief The number of secondary entities
         int n_secondary_;
+
+        /// @brief Whether the links of each primary are sorted
+        bool sorted_;
     };
 }
\ No newline at end of file
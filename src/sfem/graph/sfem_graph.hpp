@@ -5,5 +5,6 @@ namespace sfem::graph
 {
 }
 
+#include <sfem/graph/coloring.hpp>
 #include <sfem/graph/connectivity.hpp>
 #include <sfem/graph/partition.hpp>
\ No newline at end of file
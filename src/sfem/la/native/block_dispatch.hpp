@@ -0,0 +1,36 @@
+#pragma once
+
+#include <type_traits>
+
+namespace sfem::la
+{
+    /// @brief Largest block size for which specialized kernels are instantiated
+    inline constexpr int max_static_block_size = 6;
+
+    /// @brief Invoke a kernel specialized for a given block size
+    /// @param bs Block size
+    /// @param kernel Callable accepting a std::integral_constant<int, BS>, where
+    /// BS equals bs for block sizes up to max_static_block_size and 0 otherwise,
+    /// in which case the kernel should fall back to the runtime block size
+    template <typename Kernel>
+    decltype(auto) dispatch_block_size(int bs, Kernel &&kernel)
+    {
+        switch (bs)
+        {
+        case 1:
+            return kernel(std::integral_constant<int, 1>{});
+        case 2:
+            return kernel(std::integral_constant<int, 2>{});
+        case 3:
+            return kernel(std::integral_constant<int, 3>{});
+        case 4:
+            return kernel(std::integral_constant<int, 4>{});
+        case 5:
+            return kernel(std::integral_constant<int, 5>{});
+        case 6:
+            return kernel(std::integral_constant<int, 6>{});
+        default:
+            return kernel(std::integral_constant<int, 0>{});
+        }
+    }
+}
@@ -0,0 +1,232 @@
+#include "bsr_matrix.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Compute y = Ax for the rows in [row_begin, row_end), or for the rows
+    /// rows[row_begin], ..., rows[row_end - 1] if a row list is given.
+    /// BS is the block size, or 0 if it is only known at runtime (bs_runtime)
+    template <int BS>
+    static void bsr_spmv_rows(const graph::Connectivity &row_to_col,
+                              const real_t *a,
+                              const real_t *x,
+                              real_t *y,
+                              const int *rows,
+                              int row_begin,
+                              int row_end,
+                              int bs_runtime)
+    {
+        if constexpr (BS > 0)
+        {
+            // Each block is applied as a sum of its (padded) columns scaled by
+            // the entries of x, i.e. fixed-length vector operations
+            constexpr int LD = bsr_leading_dim(BS);
+            for (int k = row_begin; k < row_end; k++)
+            {
+                const int r = rows ? rows[k] : k;
+                const auto cols = row_to_col.links(r);
+                const real_t *ar = a + row_to_col.offset(r) * BS * LD;
+                std::array<real_t, LD> acc{};
+                for (std::size_t c = 0; c < cols.size(); c++)
+                {
+                    const real_t *ac = ar + c * BS * LD;
+                    const real_t *xc = x + cols[c] * BS;
+                    for (int k2 = 0; k2 < BS; k2++)
+                    {
+                        const real_t xk = xc[k2];
+                        const real_t *col = ac + k2 * LD;
+                        SFEM_OMP(simd)
+                        for (int k1 = 0; k1 < LD; k1++)
+                        {
+                            acc[k1] += col[k1] * xk;
+                        }
+                    }
+                }
+                std::copy_n(acc.cbegin(), BS, y + r * BS);
+            }
+        }
+        else
+        {
+            const int bs = bs_runtime;
+            const int ld = bsr_leading_dim(bs);
+            for (int k = row_begin; k < row_end; k++)
+            {
+                const int r = rows ? rows[k] : k;
+                const auto cols = row_to_col.links(r);
+                const real_t *ar = a + row_to_col.offset(r) * bs * ld;
+                real_t *yr = y + r * bs;
+                std::fill(yr, yr + bs, 0.0);
+                for (std::size_t c = 0; c < cols.size(); c++)
+                {
+                    const real_t *ac = ar + c * bs * ld;
+                    const real_t *xc = x + cols[c] * bs;
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        for (int k1 = 0; k1 < bs; k1++)
+                        {
+                            yr[k1] += ac[k2 * ld + k1] * xc[k2];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    void pack_blocks(int bs, int n_blocks, const real_t *src, real_t *dest)
+    {
+        const int ld = bsr_leading_dim(bs);
+        SFEM_OMP(parallel for)
+        for (int b = 0; b < n_blocks; b++)
+        {
+            const real_t *sb = src + b * bs * bs;
+            real_t *db = dest + b * bs * ld;
+            for (int k2 = 0; k2 < bs; k2++)
+            {
+                for (int k1 = 0; k1 < ld; k1++)
+                {
+                    db[k2 * ld + k1] = k1 < bs ? sb[k1 * bs + k2] : 0.0;
+                }
+            }
+        }
+    }
+    //=============================================================================
+    BSRMatrix::BSRMatrix(const SparseMatrix &A)
+        : A_(A),
+          ld_(bsr_leading_dim(A.block_size()))
+    {
+        if (A_.index_maps()[0] != A_.index_maps()[1])
+        {
+            SFEM_ERROR("BSRMatrix requires a square matrix with the same row and column index map\n");
+        }
+        update_values();
+    }
+    //=============================================================================
+    void BSRMatrix::update_values()
+    {
+        const int bs = A_.block_size();
+        const int n_blocks = A_.connectivity()->n_links();
+        values_.resize(n_blocks * bs * ld_);
+        pack_blocks(bs, n_blocks, A_.values().data(), values_.data());
+    }
+    //=============================================================================
+    std::shared_ptr<const graph::Connectivity> BSRMatrix::connectivity() const
+    {
+        return A_.connectivity();
+    }
+    //=============================================================================
+    int BSRMatrix::leading_dim() const
+    {
+        return ld_;
+    }
+    //=============================================================================
+    const std::vector<real_t> &BSRMatrix::values() const
+    {
+        return values_;
+    }
+    //=============================================================================
+    std::shared_ptr<const IndexMap> BSRMatrix::index_map() const
+    {
+        return A_.index_maps()[0];
+    }
+    //=============================================================================
+    int BSRMatrix::block_size() const
+    {
+        return A_.block_size();
+    }
+    //=============================================================================
+    void BSRMatrix::apply(Vector &x, Vector &y) const
+    {
+        spmv_overlap(*this, x, y);
+    }
+    //=============================================================================
+    void BSRMatrix::diagonal(Vector &diag) const
+    {
+        A_.diagonal(diag);
+    }
+    //=============================================================================
+    const SparseMatrix *BSRMatrix::matrix() const
+    {
+        return &A_;
+    }
+    //=============================================================================
+    void spmv(const BSRMatrix &A,
+              const Vector &x,
+              Vector &y)
+    {
+        const int bs = A.block_size();
+        const auto im = A.index_map();
+
+        SFEM_CHECK_SIZES(im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(bs, x.block_size());
+        SFEM_CHECK_SIZES(bs, y.block_size());
+
+        const auto row_to_col = A.connectivity();
+        const auto &row_blocks = A.matrix()->row_blocks();
+        const int n_blocks = static_cast<int>(row_blocks.size()) - 1;
+        const real_t *a = A.values().data();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                            {
+                                SFEM_OMP(parallel for schedule(static, 1))
+                                for (int b = 0; b < n_blocks; b++)
+                                {
+                                    bsr_spmv_rows<BS>(*row_to_col, a, xv, yv, nullptr,
+                                                      row_blocks[b], row_blocks[b + 1], bs);
+                                } });
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + im->n_owned() * bs, y.values().end(), 0.0);
+    }
+    //=============================================================================
+    void spmv_overlap(const BSRMatrix &A,
+                      Vector &x,
+                      Vector &y)
+    {
+        const int bs = A.block_size();
+        const auto im = A.index_map();
+
+        SFEM_CHECK_SIZES(im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(bs, x.block_size());
+        SFEM_CHECK_SIZES(bs, y.block_size());
+
+        const auto row_to_col = A.connectivity();
+        const real_t *a = A.values().data();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+        const int n_threads = omp::n_threads();
+
+        // Compute y = Ax for a list of rows, split evenly among the threads
+        auto multiply_rows = [&](std::span<const int> rows)
+        {
+            const int n_rows = static_cast<int>(rows.size());
+            dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                                {
+                                    SFEM_OMP(parallel for schedule(static, 1))
+                                    for (int t = 0; t < n_threads; t++)
+                                    {
+                                        bsr_spmv_rows<BS>(*row_to_col, a, xv, yv, rows.data(),
+                                                          n_rows * t / n_threads,
+                                                          n_rows * (t + 1) / n_threads, bs);
+                                    } });
+        };
+
+        // The interior rows only require the owned values of x,
+        // so they are computed while the ghost values are exchanged
+        x.update_ghosts_begin();
+        multiply_rows(A.matrix()->interior_rows());
+        x.update_ghosts_end();
+        multiply_rows(A.matrix()->boundary_rows());
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + im->n_owned() * bs, y.values().end(), 0.0);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/graph/connectivity.hpp>
+#include <sfem/base/config.hpp>
+#include <vector>
+
+namespace sfem::la
+{
+    /// @brief Get the leading dimension of the (column-major) blocks of a BSR matrix,
+    /// i.e. the block size rounded up to a multiple of the SIMD width (4 values),
+    /// so that each block column is a fixed-length vector. Block sizes up to 2 are not padded
+    constexpr int bsr_leading_dim(int bs)
+    {
+        return bs <= 2 ? bs : (bs + 3) / 4 * 4;
+    }
+
+    /// @brief Convert row-major blocks to padded column-major blocks
+    /// @param bs Block size
+    /// @param n_blocks Number of blocks
+    /// @param src Row-major blocks (bs x bs values each)
+    /// @param dest Column-major blocks (bs x bsr_leading_dim(bs) values each),
+    /// with the padding set to zero
+    void pack_blocks(int bs, int n_blocks, const real_t *src, real_t *dest);
+
+    /// @brief MPI-parallel sparse matrix in block CSR (BSR) format, with column-major blocks
+    /// whose columns are padded to the SIMD width (see bsr_leading_dim), so that the block
+    /// kernels vectorize over the rows of each block.
+    ///
+    /// A BSRMatrix is a copy of an assembled SparseMatrix, with the same sparsity and index maps.
+    /// The SparseMatrix remains the target of assembly, and is returned by matrix(), so that
+    /// preconditioners requiring the matrix entries can be set up from the BSRMatrix
+    /// @note The matrix is referenced, thus it must outlive the BSRMatrix
+    class BSRMatrix : public LinearOperator
+    {
+    public:
+        /// @brief Create a BSRMatrix
+        /// @param A Sparse matrix (square)
+        BSRMatrix(const SparseMatrix &A);
+
+        /// @brief Copy the values of the sparse matrix, e.g. after re-assembly
+        void update_values();
+
+        /// @brief Get the row-to-column connectivity
+        std::shared_ptr<const graph::Connectivity> connectivity() const;
+
+        /// @brief Get the leading dimension of the blocks
+        int leading_dim() const;
+
+        /// @brief Get the block values
+        const std::vector<real_t> &values() const;
+
+        std::shared_ptr<const IndexMap> index_map() const override;
+
+        int block_size() const override;
+
+        void apply(Vector &x, Vector &y) const override;
+
+        void diagonal(Vector &diag) const override;
+
+        const SparseMatrix *matrix() const override;
+
+    private:
+        /// @brief Sparse matrix
+        const SparseMatrix &A_;
+
+        /// @brief Leading dimension of the blocks
+        int ld_;
+
+        /// @brief Block values (padded column-major blocks)
+        std::vector<real_t> values_;
+    };
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax
+    /// @note The ghost index values of x should be updated before calling
+    void spmv(const BSRMatrix &A, const Vector &x, Vector &y);
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax, with the ghost value update of x
+    /// overlapped with the multiplication of the interior rows
+    /// @note Updates the ghost index values of x
+    void spmv_overlap(const BSRMatrix &A, Vector &x, Vector &y);
+}
\ No newline at end of file
@@ -50,6 +50,17 @@ namespace sfem::la
         std::fill(values_.begin(), values_.end(), value);
     }
     //=============================================================================
+    void DenseMatrix::resize(int n_rows, int n_cols, real_t value)
+    {
+        if (n_rows <= 0 || n_cols <= 0)
+        {
+            SFEM_ERROR(std::format("Invalid number of rows {}, or columns {}\n", n_rows, n_cols));
+        }
+        n_rows_ = n_rows;
+        n_cols_ = n_cols;
+        values_.assign(n_rows * n_cols, value);
+    }
+    //=============================================================================
     DenseMatrix DenseMatrix::copy() const
     {
         std::vector<real_t> data = values_;
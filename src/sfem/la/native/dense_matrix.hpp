@@ -47,6 +47,10 @@ namespace sfem::la
         /// @brief Set all matrix values to a uniform value
         void set_all(real_t value);
 
+        /// @brief Change the matrix dimensions and set all values to a uniform value
+        /// @note The existing storage is reused if it is large enough
+        void resize(int n_rows, int n_cols, real_t value = 0.0);
+
         /// @brief Get a copy of the matrix
         DenseMatrix copy() const;
 
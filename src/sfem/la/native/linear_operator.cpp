@@ -0,0 +1,42 @@
+#include "linear_operator.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+
+namespace sfem::la
+{
+    //=============================================================================
+    const SparseMatrix *LinearOperator::matrix() const
+    {
+        return nullptr;
+    }
+    //=============================================================================
+    MatrixOperator::MatrixOperator(const SparseMatrix &A)
+        : A_(A)
+    {
+    }
+    //=============================================================================
+    std::shared_ptr<const IndexMap> MatrixOperator::index_map() const
+    {
+        return A_.index_maps()[0];
+    }
+    //=============================================================================
+    int MatrixOperator::block_size() const
+    {
+        return A_.block_size();
+    }
+    //=============================================================================
+    void MatrixOperator::apply(Vector &x, Vector &y) const
+    {
+        spmv_overlap(A_, x, y);
+    }
+    //=============================================================================
+    void MatrixOperator::diagonal(Vector &diag) const
+    {
+        A_.diagonal(diag);
+    }
+    //=============================================================================
+    const SparseMatrix *MatrixOperator::matrix() const
+    {
+        return &A_;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <sfem/parallel/index_map.hpp>
+#include <memory>
+
+namespace sfem::la
+{
+    // Forward declarations
+    class Vector;
+    class SparseMatrix;
+
+    /// @brief Linear operator ABC, i.e. the action y = Ax of a square (block) matrix A,
+    /// which need not be stored explicitly (matrix-free operators)
+    class LinearOperator
+    {
+    public:
+        // Destructor
+        virtual ~LinearOperator() = default;
+
+        /// @brief Get the (row and column) index map
+        virtual std::shared_ptr<const IndexMap> index_map() const = 0;
+
+        /// @brief Get the block size
+        virtual int block_size() const = 0;
+
+        /// @brief Apply the operator, i.e. compute y = Ax
+        /// @note Updates the ghost index values of x.
+        /// Only the values of owned indices of y are computed
+        virtual void apply(Vector &x, Vector &y) const = 0;
+
+        /// @brief Compute the diagonal of the operator, for the owned indices
+        virtual void diagonal(Vector &diag) const = 0;
+
+        /// @brief Get the assembled matrix of the operator
+        /// @note Returns nullptr for matrix-free operators
+        virtual const SparseMatrix *matrix() const;
+    };
+
+    /// @brief Linear operator of an assembled sparse matrix
+    /// @note The matrix is referenced, thus it must outlive the operator
+    class MatrixOperator : public LinearOperator
+    {
+    public:
+        /// @brief Create a MatrixOperator
+        /// @param A Sparse matrix
+        MatrixOperator(const SparseMatrix &A);
+
+        std::shared_ptr<const IndexMap> index_map() const override;
+
+        int block_size() const override;
+
+        void apply(Vector &x, Vector &y) const override;
+
+        void diagonal(Vector &diag) const override;
+
+        const SparseMatrix *matrix() const override;
+
+    private:
+        /// @brief Sparse matrix
+        const SparseMatrix &A_;
+    };
+}
\ No newline at end of file
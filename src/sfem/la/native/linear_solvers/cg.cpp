@@ -1,5 +1,5 @@
 #include "cg.hpp"
-#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/linear_operator.hpp>
 
 namespace sfem::la
 {
@@ -8,35 +8,38 @@ namespace sfem::la
         : LinearSolver("CG", options),
           Ap(std::make_shared<IndexMap>(), 1),
           p(std::make_shared<IndexMap>(), 1),
-          r(std::make_shared<IndexMap>(), 1)
+          r(std::make_shared<IndexMap>(), 1),
+          z(std::make_shared<IndexMap>(), 1),
+          rz_(0.0)
     {
     }
     //=============================================================================
-    void CG::init(const SparseMatrix &A,
+    void CG::init(const LinearOperator &A,
                   const Vector &b, Vector &x)
     {
         Ap = Vector(x.index_map(), x.block_size());
-        spmv(A, x, Ap);
+        A.apply(x, Ap);
 
         r = Vector(x.index_map(), x.block_size());
         axpbypc(1, -1, 0, b, Ap, r);
         residual_history_[0] = norm(r, NormType::l2);
 
+        z = Vector(x.index_map(), x.block_size());
+        precondition(r, z);
+        rz_ = pc_ ? dot(r, z) : residual_history_[0] * residual_history_[0];
+
         p = Vector(x.index_map(), x.block_size());
-        copy(r, p);
+        copy(z, p);
     }
     //=============================================================================
-    void CG::single_iteration(int iter, const SparseMatrix &A,
+    void CG::single_iteration(int iter, const LinearOperator &A,
                               [[maybe_unused]] const Vector &b, Vector &x)
     {
         // Compute Ap (intermediate product)
-        p.update_ghosts();
-        spmv(A, p, Ap);
-
-        const real_t res_old = residual_history_[iter - 1];
+        A.apply(p, Ap);
 
         // Compute step size
-        const real_t alpha = res_old * res_old / (dot(p, Ap));
+        const real_t alpha = rz_ / dot(p, Ap);
 
         // Update solution vector x = x + alpha * p
         axpy(alpha, p, x);
@@ -46,8 +49,14 @@ namespace sfem::la
         const real_t res_new = norm(r, NormType::l2);
         residual_history_[iter] = res_new;
 
-        // Update search direction vector: p = r + beta * p
-        const real_t beta = (res_new * res_new) / (res_old * res_old);
-        axpbypc(1, beta, 0, r, p, p);
+        // Apply the preconditioner: z = M^-1 r
+        // Without a preconditioner z = r, thus (r, z) = ||r||^2
+        precondition(r, z);
+        const real_t rz_old = rz_;
+        rz_ = pc_ ? dot(r, z) : res_new * res_new;
+
+        // Update search direction vector: p = z + beta * p
+        const real_t beta = rz_ / rz_old;
+        axpbypc(1, beta, 0, z, p, p);
     }
 }
\ No newline at end of file
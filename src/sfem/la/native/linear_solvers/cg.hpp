@@ -5,16 +5,16 @@
 
 namespace sfem::la
 {
-    /// @brief Conjugate Gradient solver
+    /// @brief (Preconditioned) Conjugate Gradient solver
     class CG : public LinearSolver
     {
     public:
         CG(SolverOptions options = {});
 
     private:
-        void init(const SparseMatrix &A, const Vector &b, Vector &x) override;
+        void init(const LinearOperator &A, const Vector &b, Vector &x) override;
 
-        void single_iteration(int iter, const SparseMatrix &A, const Vector &b, Vector &x) override;
+        void single_iteration(int iter, const LinearOperator &A, const Vector &b, Vector &x) override;
 
     private:
         /// @brief  Workspace vector, used for storing intermediate products
@@ -25,5 +25,11 @@ namespace sfem::la
 
         // Residual vector
         Vector r;
+
+        // Preconditioned residual vector
+        Vector z;
+
+        /// @brief Inner product of the residual and preconditioned residual vectors
+        real_t rz_;
     };
 }
\ No newline at end of file
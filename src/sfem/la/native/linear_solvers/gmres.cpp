@@ -1,6 +1,7 @@
 #include "gmres.hpp"
-#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/linear_operator.hpp>
 #include <sfem/base/error.hpp>
+#include <limits>
 
 namespace sfem::la
 {
@@ -9,16 +10,21 @@ namespace sfem::la
         : LinearSolver("GMRES", options),
           n_restart_(n_restart),
           x0_(std::make_shared<IndexMap>(), 1),
+          z_(std::make_shared<IndexMap>(), 1),
+          w_(std::make_shared<IndexMap>(), 1),
           H_(n_restart_ + 1, n_restart_),
-          e1_(n_restart_ + 1, 1)
+          e1_(n_restart_ + 1, 1),
+          y_(n_restart_, 1)
     {
     }
     //=============================================================================
-    void GMRES::init(const SparseMatrix &A,
+    void GMRES::init(const LinearOperator &A,
                      const Vector &b, Vector &x)
     {
         // Allocate workspace objects
         x0_ = Vector(b.index_map(), b.block_size());
+        z_ = Vector(b.index_map(), b.block_size());
+        w_ = Vector(b.index_map(), b.block_size());
         Q_.clear();
         for (int i = 0; i < n_restart_ + 1; i++)
         {
@@ -29,11 +35,10 @@ namespace sfem::la
         restart(0, A, b, x);
     }
     //=============================================================================
-    void GMRES::restart(int iter, const SparseMatrix &A, const Vector &b, Vector &x)
+    void GMRES::restart(int iter, const LinearOperator &A, const Vector &b, Vector &x)
     {
         // Save initial solution vector
         copy(x, x0_);
-        x0_.update_ghosts();
 
         // Reset basis vectors
         for (auto &q : Q_)
@@ -42,7 +47,7 @@ namespace sfem::la
         }
 
         // Compute initial residual vector and its norm
-        spmv(A, x0_, Q_[0]);
+        A.apply(x0_, Q_[0]);
         axpy(-1, b, Q_[0]);
         residual_history_[iter] = norm(Q_[0], NormType::l2);
 
@@ -105,14 +110,14 @@ namespace sfem::la
         return DenseMatrix(n, 1, std::move(x_values));
     }
     //=============================================================================
-    void GMRES::single_iteration(int iter, const SparseMatrix &A,
+    void GMRES::single_iteration(int iter, const LinearOperator &A,
                                  const Vector &b, Vector &x)
     {
         const int k = riter_;
 
-        // Perform a single Arnoldi iteration
-        Q_[k].update_ghosts();
-        spmv(A, Q_[k], Q_[k + 1]);
+        // Perform a single Arnoldi iteration for the operator A * M^-1
+        precondition(Q_[k], z_);
+        A.apply(z_, Q_[k + 1]);
         for (int j = 0; j < k + 1; j++)
         {
             H_(j, k) = dot(Q_[j], Q_[k + 1]);
@@ -129,27 +134,43 @@ namespace sfem::la
         auto Hk = submatrix(H_, 0, k + 2, 0, k + 1);
         auto e1k = submatrix(e1_, 0, k + 2, 0, 1);
         // auto yk = lstsq(Hk, e1k);
-        auto yk = Hk.invert().first * e1k;
-
-        // Update solution vector
-        copy(x0_, x);
-        for (int j = 0; j < k + 1; j++)
-        {
-            axpy(yk(j, 0), Q_[j], x);
-        }
+        y_ = Hk.invert().first * e1k;
 
         // Increment iteration (since last restart)
         riter_++;
 
-        // Perform a restart, if required
-        // Else, update residual history
+        // Perform a restart, if required, forming the solution vector
+        // Else, update residual history (the solution vector is formed by finalize)
         if (riter_ == n_restart_)
         {
+            update_solution(x);
             restart(iter, A, b, x);
         }
         else
         {
-            residual_history_[iter] = norm(Hk * yk - e1k);
+            residual_history_[iter] = norm(Hk * y_ - e1k);
+        }
+    }
+    //=============================================================================
+    void GMRES::finalize([[maybe_unused]] const LinearOperator &A,
+                         [[maybe_unused]] const Vector &b, Vector &x)
+    {
+        if (riter_ > 0)
+        {
+            update_solution(x);
+        }
+    }
+    //=============================================================================
+    void GMRES::update_solution(Vector &x)
+    {
+        // The preconditioner is applied once to the combination of the basis vectors
+        w_.set_all(0.0);
+        for (int j = 0; j < riter_; j++)
+        {
+            axpy(y_(j, 0), Q_[j], w_);
         }
+        precondition(w_, z_);
+        copy(x0_, x);
+        axpy(1.0, z_, x);
     }
 }
\ No newline at end of file
@@ -6,18 +6,23 @@
 
 namespace sfem::la
 {
-    /// @brief Generalized Minimum Residual solver
+    /// @brief Generalized Minimum Residual solver (right-preconditioned)
     class GMRES : public LinearSolver
     {
     public:
         GMRES(SolverOptions options = {}, int n_restart = 50);
 
     private:
-        void init(const SparseMatrix &A, const Vector &b, Vector &x) override;
+        void init(const LinearOperator &A, const Vector &b, Vector &x) override;
 
-        void single_iteration(int iter, const SparseMatrix &A, const Vector &b, Vector &x) override;
+        void single_iteration(int iter, const LinearOperator &A, const Vector &b, Vector &x) override;
 
-        void restart(int iter, const SparseMatrix &A, const Vector &b, Vector &x);
+        void finalize(const LinearOperator &A, const Vector &b, Vector &x) override;
+
+        void restart(int iter, const LinearOperator &A, const Vector &b, Vector &x);
+
+        /// @brief Update the solution vector: x = x0 + M^-1 * (Q * y)
+        void update_solution(Vector &x);
 
     private:
         /// @brief Number of iterations before restart
@@ -32,10 +37,17 @@ namespace sfem::la
         /// @brief Krylov subspace orthonormal basis vectors
         std::vector<Vector> Q_;
 
+        /// @brief Workspace vectors, used for storing preconditioned vectors
+        Vector z_;
+        Vector w_;
+
         /// @brief Hessenberg matrix
         DenseMatrix H_;
 
         /// @brief e1 vector (e1=[||r0||, 0, 0, ..., 0]^T)
         DenseMatrix e1_;
+
+        /// @brief Least squares solution of the last iteration
+        DenseMatrix y_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "iterative_refinement.hpp"
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/base/error.hpp>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Get the options of the inner solves, i.e. those of the outer iterations
+    /// with a loose relative tolerance. The inner solves only need to reduce the residual
+    /// by a modest factor, the outer iterations are responsible for the final accuracy
+    static SolverOptions inner_solver_options(SolverOptions options, real_t inner_rtol)
+    {
+        options.atol = 0.0;
+        options.rtol = inner_rtol;
+        options.print_conv = false;
+        options.print_iter = false;
+        return options;
+    }
+    //=============================================================================
+    IterativeRefinement::IterativeRefinement(SolverOptions options,
+                                             SolverType inner_type,
+                                             real_t inner_rtol)
+        : LinearSolver("IterativeRefinement", options),
+          inner_rtol_(inner_rtol),
+          Ax(std::make_shared<IndexMap>(), 1),
+          r(std::make_shared<IndexMap>(), 1),
+          d(std::make_shared<IndexMap>(), 1)
+    {
+        if (inner_type == SolverType::ir_cg or inner_type == SolverType::ir_gmres)
+        {
+            SFEM_ERROR("Invalid inner solver type for IterativeRefinement\n");
+        }
+        inner_.reset(create_solver(inner_type, inner_solver_options(options, inner_rtol)));
+    }
+    //=============================================================================
+    bool IterativeRefinement::sets_up_preconditioner() const
+    {
+        // The preconditioner is that of the inner solver
+        return false;
+    }
+    //=============================================================================
+    real_t IterativeRefinement::compute_residual(const LinearOperator &A,
+                                                 const Vector &b, Vector &x)
+    {
+        A.apply(x, Ax);
+        axpbypc(1, -1, 0, b, Ax, r);
+        return norm(r, NormType::l2);
+    }
+    //=============================================================================
+    void IterativeRefinement::init(const LinearOperator &A,
+                                   const Vector &b, Vector &x)
+    {
+        if (A.matrix() == nullptr)
+        {
+            SFEM_ERROR("IterativeRefinement requires an assembled matrix\n");
+        }
+
+        // Keep the single precision copy across runs with the same matrix,
+        // only its values may have changed (e.g. re-assembly)
+        if (A_sp_ and A_sp_->matrix() == A.matrix())
+        {
+            A_sp_->update_values();
+        }
+        else
+        {
+            A_sp_ = std::make_unique<SinglePrecisionMatrix>(*A.matrix());
+        }
+
+        // Pass the current options on to the inner solver, thus the preconditioner
+        // is set up in the first inner solve, unless it is reused across runs
+        inner_->options() = inner_solver_options(options_, inner_rtol_);
+
+        Ax = Vector(x.index_map(), x.block_size());
+        r = Vector(x.index_map(), x.block_size());
+        d = Vector(x.index_map(), x.block_size());
+        residual_history_[0] = compute_residual(A, b, x);
+    }
+    //=============================================================================
+    void IterativeRefinement::single_iteration(int iter, const LinearOperator &A,
+                                               const Vector &b, Vector &x)
+    {
+        // Solve the correction equation in single precision: A d = r
+        d.set_all(0.0);
+        inner_->run(*A_sp_, r, d);
+        inner_->options().reuse_pc = true;
+
+        // Update solution vector x = x + d
+        axpy(1, d, x);
+
+        // Compute the residual in working precision: r = b - Ax
+        residual_history_[iter] = compute_residual(A, b, x);
+    }
+}
\ No newline at end of file
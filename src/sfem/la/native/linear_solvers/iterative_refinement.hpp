@@ -0,0 +1,62 @@
+#pragma once
+
+#include <sfem/la/native/linear_solvers/linear_solver_factory.hpp>
+#include <sfem/la/native/single_precision_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+
+namespace sfem::la
+{
+    /// @brief Mixed-precision iterative refinement solver.
+    ///
+    /// Each iteration computes the residual r = b - Ax with the original operator, solves the
+    /// correction equation A d = r with an inner solver (CG or GMRES) to a loose tolerance, using
+    /// a copy of the matrix with values stored in single precision (see SinglePrecisionMatrix),
+    /// and updates x = x + d. Vectors and reductions are in working precision throughout, thus
+    /// the final residual is that of the original system, while most SpMVs stream half the bytes.
+    ///
+    /// The options are passed on to the inner solver at every run, except for the tolerances and
+    /// printing. Thus the preconditioner (options.pc_type) is that of the inner solver: it is set
+    /// up from the matrix once per run (or kept from the previous run if options.reuse_pc), and
+    /// reused by the subsequent inner solves
+    /// @note Requires an assembled matrix, i.e. A.matrix() != nullptr
+    class IterativeRefinement : public LinearSolver
+    {
+    public:
+        /// @brief Create an IterativeRefinement solver
+        /// @param options Solver options (of the outer iterations)
+        /// @param inner_type Type of the inner solver
+        /// @param inner_rtol Relative tolerance of the inner solves
+        IterativeRefinement(SolverOptions options = {},
+                            SolverType inner_type = SolverType::cg,
+                            real_t inner_rtol = 1e-4);
+
+    private:
+        bool sets_up_preconditioner() const override;
+
+        void init(const LinearOperator &A, const Vector &b, Vector &x) override;
+
+        void single_iteration(int iter, const LinearOperator &A, const Vector &b, Vector &x) override;
+
+        /// @brief Compute the residual r = b - Ax and its norm
+        real_t compute_residual(const LinearOperator &A, const Vector &b, Vector &x);
+
+    private:
+        /// @brief Inner solver
+        std::unique_ptr<LinearSolver> inner_;
+
+        /// @brief Relative tolerance of the inner solves
+        real_t inner_rtol_;
+
+        /// @brief Matrix in single precision, kept across runs with the same matrix
+        std::unique_ptr<SinglePrecisionMatrix> A_sp_;
+
+        /// @brief Workspace vector, used for storing intermediate products
+        Vector Ax;
+
+        // Residual vector
+        Vector r;
+
+        // Correction vector
+        Vector d;
+    };
+}
\ No newline at end of file
@@ -2,13 +2,15 @@
 #include <sfem/base/error.hpp>
 #include <sfem/la/native/vector.hpp>
 #include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/linear_operator.hpp>
 
 namespace sfem::la
 {
     //=============================================================================
     LinearSolver::LinearSolver(const std::string &name, SolverOptions options)
         : name_(name),
-          options_(options)
+          options_(options),
+          pc_type_(PreconditionerType::none)
     {
     }
     //=============================================================================
@@ -32,7 +34,38 @@ namespace sfem::la
         return residual_history_;
     }
     //=============================================================================
+    std::shared_ptr<const Preconditioner> LinearSolver::preconditioner() const
+    {
+        return pc_;
+    }
+    //=============================================================================
+    void LinearSolver::precondition(const Vector &r, Vector &z) const
+    {
+        if (pc_)
+        {
+            pc_->apply(r, z);
+        }
+        else
+        {
+            copy(r, z);
+        }
+    }
+    //=============================================================================
+    void LinearSolver::finalize(const LinearOperator &, const Vector &, Vector &)
+    {
+    }
+    //=============================================================================
+    bool LinearSolver::sets_up_preconditioner() const
+    {
+        return true;
+    }
+    //=============================================================================
     bool LinearSolver::run(const SparseMatrix &A, const Vector &b, Vector &x)
+    {
+        return run(MatrixOperator(A), b, x);
+    }
+    //=============================================================================
+    bool LinearSolver::run(const LinearOperator &A, const Vector &b, Vector &x)
     {
         // Check that options are valid
         if (options_.atol < 0)
@@ -55,6 +88,23 @@ namespace sfem::la
         // Reset residual history
         residual_history_.resize(options_.n_iter_max + 1, 0.0);
 
+        // Set up the preconditioner for the current operator
+        bool new_pc = false;
+        if (not sets_up_preconditioner())
+        {
+            pc_ = nullptr;
+        }
+        else if (pc_ == nullptr or pc_type_ != options_.pc_type)
+        {
+            pc_.reset(create_preconditioner(options_.pc_type));
+            pc_type_ = options_.pc_type;
+            new_pc = true;
+        }
+        if (pc_ and (new_pc or not options_.reuse_pc))
+        {
+            pc_->setup(A);
+        }
+
         // Initialize the solver
         init(A, b, x);
         if (options_.print_iter)
@@ -85,11 +135,14 @@ namespace sfem::la
             // Check for divergence
             if (residual_history_[iter] >= options_.dtol * r0)
             {
+                finalize(A, b, x);
                 log_msg(std::format("{} has diverged in {} iterations\n", name_, iter), true);
                 return false;
             }
         }
 
+        finalize(A, b, x);
+
         // Check for convergence
         bool converged = residual_history_[iter] < tol ? true : false;
 
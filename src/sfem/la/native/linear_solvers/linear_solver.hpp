@@ -1,6 +1,8 @@
 #pragma once
 
+#include <sfem/la/native/preconditioners/preconditioner_factory.hpp>
 #include <sfem/base/config.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -9,6 +11,7 @@ namespace sfem::la
     // Forward declarations
     class Vector;
     class SparseMatrix;
+    class LinearOperator;
 
     /// @brief Linear solver options
     struct SolverOptions
@@ -30,6 +33,13 @@ namespace sfem::la
 
         /// @brief Whether to print iteration info
         bool print_iter = false;
+
+        /// @brief Preconditioner type
+        PreconditionerType pc_type = PreconditionerType::none;
+
+        /// @brief Whether to reuse the preconditioner of the previous run (if of the same type),
+        /// skipping its setup, e.g. for repeated solves with the same matrix
+        bool reuse_pc = false;
     };
 
     /// @brief Linear solver ABC
@@ -51,17 +61,36 @@ namespace sfem::la
         /// @brief Get the solver's residual history
         std::vector<real_t> residual_history() const;
 
+        /// @brief Get the solver's preconditioner
+        /// @note Returns nullptr if no preconditioner is used
+        std::shared_ptr<const Preconditioner> preconditioner() const;
+
         /// @brief Run the solver, i.e. solve Ax=b for x
         bool run(const SparseMatrix &A, const Vector &b, Vector &x);
 
+        /// @brief Run the solver for a (possibly matrix-free) linear operator
+        bool run(const LinearOperator &A, const Vector &b, Vector &x);
+
     protected:
         /// @brief Initialize various solver attributes such as workspace vectors.
         /// @note Should also compute the first (0-th) residual
-        virtual void init(const SparseMatrix &A, const Vector &b, Vector &x) = 0;
+        virtual void init(const LinearOperator &A, const Vector &b, Vector &x) = 0;
 
         /// @brief Perform a single solver iteration, updating the solution values
         /// @note Should also update residual history
-        virtual void single_iteration(int iter, const SparseMatrix &A, const Vector &b, Vector &x) = 0;
+        virtual void single_iteration(int iter, const LinearOperator &A, const Vector &b, Vector &x) = 0;
+
+        /// @brief Complete the solution values after the last iteration
+        /// @note For solvers which do not update the solution at every iteration (e.g. GMRES)
+        virtual void finalize(const LinearOperator &A, const Vector &b, Vector &x);
+
+        /// @brief Whether the preconditioner (options.pc_type) is set up by run()
+        /// @note For solvers which delegate the preconditioning (e.g. to an inner solver)
+        virtual bool sets_up_preconditioner() const;
+
+        /// @brief Apply the preconditioner, i.e. compute z = M^-1 r
+        /// @note If no preconditioner is used, r is copied to z
+        void precondition(const Vector &r, Vector &z) const;
 
     protected:
         /// @brief Solver name
@@ -72,5 +101,11 @@ namespace sfem::la
 
         /// @brief Residual norm history
         std::vector<real_t> residual_history_;
+
+        /// @brief Preconditioner
+        std::shared_ptr<Preconditioner> pc_;
+
+        /// @brief Type of the current preconditioner
+        PreconditionerType pc_type_;
     };
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "linear_solver_factory.hpp"
 #include <sfem/la/native/linear_solvers/gmres.hpp>
 #include <sfem/la/native/linear_solvers/cg.hpp>
+#include <sfem/la/native/linear_solvers/pipecg.hpp>
+#include <sfem/la/native/linear_solvers/iterative_refinement.hpp>
 
 namespace sfem::la
 {
@@ -15,6 +17,15 @@ namespace sfem::la
         case SolverType::gmres:
             solver = new GMRES(options);
             break;
+        case SolverType::pipecg:
+            solver = new PipeCG(options);
+            break;
+        case SolverType::ir_cg:
+            solver = new IterativeRefinement(options, SolverType::cg);
+            break;
+        case SolverType::ir_gmres:
+            solver = new IterativeRefinement(options, SolverType::gmres);
+            break;
         default:
             break;
         }
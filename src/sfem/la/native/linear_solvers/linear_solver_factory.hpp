@@ -7,7 +7,10 @@ namespace sfem::la
     enum class SolverType
     {
         gmres,
-        cg
+        cg,
+        pipecg,
+        ir_cg,
+        ir_gmres
     };
 
     LinearSolver *create_solver(SolverType type, SolverOptions options);
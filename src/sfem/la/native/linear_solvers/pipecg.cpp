@@ -0,0 +1,124 @@
+#include "pipecg.hpp"
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/parallel/mpi.hpp>
+#include <sfem/base/error.hpp>
+#include <array>
+#include <cmath>
+
+namespace sfem::la
+{
+    //=============================================================================
+    PipeCG::PipeCG(SolverOptions options)
+        : LinearSolver("PipeCG", options),
+          r_(std::make_shared<IndexMap>(), 1),
+          u_(std::make_shared<IndexMap>(), 1),
+          w_(std::make_shared<IndexMap>(), 1),
+          m_(std::make_shared<IndexMap>(), 1),
+          n_(std::make_shared<IndexMap>(), 1),
+          p_(std::make_shared<IndexMap>(), 1),
+          s_(std::make_shared<IndexMap>(), 1),
+          q_(std::make_shared<IndexMap>(), 1),
+          z_(std::make_shared<IndexMap>(), 1),
+          gamma_(0.0),
+          delta_(0.0),
+          gamma_old_(0.0),
+          alpha_old_(0.0)
+    {
+    }
+    //=============================================================================
+    void PipeCG::init(const LinearOperator &A,
+                      const Vector &b, Vector &x)
+    {
+        for (Vector *v : {&r_, &u_, &w_, &m_, &n_, &p_, &s_, &q_, &z_})
+        {
+            *v = Vector(x.index_map(), x.block_size());
+        }
+
+        // r = b - Ax
+        A.apply(x, r_);
+        axpbypc(1, -1, 0, b, r_, r_);
+
+        // u = M^-1 r, w = Au
+        precondition(r_, u_);
+        A.apply(u_, w_);
+
+        residual_history_[0] = reduce_and_apply(A);
+    }
+    //=============================================================================
+    void PipeCG::single_iteration(int iter, const LinearOperator &A,
+                                  [[maybe_unused]] const Vector &b, Vector &x)
+    {
+        // Compute the step size and search direction update factor
+        real_t alpha = gamma_ / delta_;
+        real_t beta = 0.0;
+        if (iter > 1)
+        {
+            beta = gamma_ / gamma_old_;
+            alpha = gamma_ / (delta_ - beta * gamma_ / alpha_old_);
+        }
+        gamma_old_ = gamma_;
+        alpha_old_ = alpha;
+
+        // Update the recurrences (fused, local operations only)
+        SFEM_CHECK_SIZES(x.values().size(), r_.values().size());
+        const int n = x.n_owned() * x.block_size();
+        real_t *xv = x.values().data();
+        real_t *rv = r_.values().data();
+        real_t *uv = u_.values().data();
+        real_t *wv = w_.values().data();
+        const real_t *mv = m_.values().data();
+        const real_t *nv = n_.values().data();
+        real_t *pv = p_.values().data();
+        real_t *sv = s_.values().data();
+        real_t *qv = q_.values().data();
+        real_t *zv = z_.values().data();
+
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n; i++)
+        {
+            zv[i] = nv[i] + beta * zv[i];
+            qv[i] = mv[i] + beta * qv[i];
+            sv[i] = wv[i] + beta * sv[i];
+            pv[i] = uv[i] + beta * pv[i];
+            xv[i] += alpha * pv[i];
+            rv[i] -= alpha * sv[i];
+            uv[i] -= alpha * qv[i];
+            wv[i] -= alpha * zv[i];
+        }
+
+        residual_history_[iter] = reduce_and_apply(A);
+    }
+    //=============================================================================
+    real_t PipeCG::reduce_and_apply(const LinearOperator &A)
+    {
+        // Local contributions to (r, u), (w, u) and (r, r)
+        const int n = r_.n_owned() * r_.block_size();
+        const real_t *rv = r_.values().data();
+        const real_t *uv = u_.values().data();
+        const real_t *wv = w_.values().data();
+        real_t ru = 0.0;
+        real_t wu = 0.0;
+        real_t rr = 0.0;
+        SFEM_OMP(parallel for reduction(+ : ru, wu, rr))
+        for (int i = 0; i < n; i++)
+        {
+            ru += rv[i] * uv[i];
+            wu += wv[i] * uv[i];
+            rr += rv[i] * rv[i];
+        }
+
+        std::array<real_t, 3> dots = {ru, wu, rr};
+        mpi::Request request = mpi::ireduce<real_t>(dots, mpi::ReduceOperation::sum);
+
+        // m = M^-1 w, n = Am, while the reduction is in flight
+        precondition(w_, m_);
+        A.apply(m_, n_);
+
+        mpi::wait(request);
+        gamma_ = dots[0];
+        delta_ = dots[1];
+
+        return std::sqrt(dots[2]);
+    }
+}
\ No newline at end of file
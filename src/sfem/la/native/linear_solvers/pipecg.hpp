@@ -0,0 +1,54 @@
+#pragma once
+
+#include <sfem/la/native/linear_solvers/linear_solver.hpp>
+#include <sfem/la/native/vector.hpp>
+
+namespace sfem::la
+{
+    /// @brief Pipelined (preconditioned) Conjugate Gradient solver (Ghysels & Vanroose).
+    /// The inner products of each iteration are fused into a single non-blocking
+    /// global reduction, which is overlapped with the application of the
+    /// preconditioner and the matrix-vector product
+    class PipeCG : public LinearSolver
+    {
+    public:
+        PipeCG(SolverOptions options = {});
+
+    private:
+        void init(const LinearOperator &A, const Vector &b, Vector &x) override;
+
+        void single_iteration(int iter, const LinearOperator &A, const Vector &b, Vector &x) override;
+
+        /// @brief Start the reduction of (r, u), (w, u) and (r, r), compute m = M^-1 w
+        /// and n = Am while it is in flight, then complete it
+        /// @return Residual norm
+        real_t reduce_and_apply(const LinearOperator &A);
+
+    private:
+        /// @brief Residual, preconditioned residual and its product with the matrix,
+        /// i.e. u = M^-1 r and w = Au
+        Vector r_;
+        Vector u_;
+        Vector w_;
+
+        /// @brief Preconditioned w and its product with the matrix,
+        /// i.e. m = M^-1 w and n = Am
+        Vector m_;
+        Vector n_;
+
+        /// @brief Search direction and its recurrences,
+        /// i.e. s = Ap, q = M^-1 s and z = Aq
+        Vector p_;
+        Vector s_;
+        Vector q_;
+        Vector z_;
+
+        /// @brief Inner products (r, u) and (w, u)
+        real_t gamma_;
+        real_t delta_;
+
+        /// @brief (r, u) and step size of the previous iteration
+        real_t gamma_old_;
+        real_t alpha_old_;
+    };
+}
\ No newline at end of file
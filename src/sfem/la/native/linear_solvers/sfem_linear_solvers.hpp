@@ -3,4 +3,6 @@
 #include <sfem/la/native/linear_solvers/linear_solver.hpp>
 #include <sfem/la/native/linear_solvers/gmres.hpp>
 #include <sfem/la/native/linear_solvers/cg.hpp>
+#include <sfem/la/native/linear_solvers/pipecg.hpp>
+#include <sfem/la/native/linear_solvers/iterative_refinement.hpp>
 #include <sfem/la/native/linear_solvers/linear_solver_factory.hpp>
\ No newline at end of file
@@ -10,7 +10,8 @@ namespace sfem::la
                                            int block_size)
         : A_(connectivity, index_map, index_map, block_size),
           b_(index_map, block_size),
-          solver_(create_solver(solver_type, solver_options))
+          solver_(create_solver(solver_type, solver_options)),
+          format_(MatrixFormat::csr)
     {
     }
     //=============================================================================
@@ -44,6 +45,27 @@ namespace sfem::la
         return solver_;
     }
     //=============================================================================
+    void NativeLinearSystem::set_matrix_format(MatrixFormat format)
+    {
+        if (format == MatrixFormat::sell and A_.block_size() != 1)
+        {
+            SFEM_ERROR(std::format("SELL format requires block size 1 (got {})\n", A_.block_size()));
+        }
+        if (format != format_)
+        {
+            // Release the previous conversion
+            bsr_.reset();
+            sell_.reset();
+            sell_sparsity_.reset();
+            format_ = format;
+        }
+    }
+    //=============================================================================
+    MatrixFormat NativeLinearSystem::matrix_format() const
+    {
+        return format_;
+    }
+    //=============================================================================
     void NativeLinearSystem::reset()
     {
         A_.set_all(0.0);
@@ -64,6 +86,7 @@ namespace sfem::la
     {
         A_.assemble();
         b_.assemble();
+        update_converted_matrix();
     }
     //=============================================================================
     void NativeLinearSystem::diagonal(la::Vector &diag) const
@@ -74,6 +97,7 @@ namespace sfem::la
     void NativeLinearSystem::scale_diagonal(real_t a)
     {
         A_.scale_diagonal(a);
+        update_converted_matrix();
     }
     //=============================================================================
     void NativeLinearSystem::rhs_axpy(real_t a, const la::Vector &x)
@@ -89,7 +113,54 @@ namespace sfem::la
     //=============================================================================
     bool NativeLinearSystem::solve(Vector &x)
     {
-        return solver_->run(A_, b_, x);
+        switch (format_)
+        {
+        case MatrixFormat::bsr:
+            if (bsr_ == nullptr)
+            {
+                update_converted_matrix();
+            }
+            return solver_->run(*bsr_, b_, x);
+        case MatrixFormat::sell:
+            if (sell_ == nullptr)
+            {
+                update_converted_matrix();
+            }
+            return solver_->run(*sell_, b_, x);
+        default:
+            return solver_->run(A_, b_, x);
+        }
+    }
+    //=============================================================================
+    void NativeLinearSystem::update_converted_matrix()
+    {
+        switch (format_)
+        {
+        case MatrixFormat::bsr:
+            if (bsr_)
+            {
+                bsr_->update_values();
+            }
+            else
+            {
+                bsr_ = std::make_unique<BSRMatrix>(A_);
+            }
+            break;
+        case MatrixFormat::sell:
+            // Slicing depends on the sparsity only
+            if (sell_ and sell_sparsity_ == A_.connectivity())
+            {
+                sell_->update_values();
+            }
+            else
+            {
+                sell_ = std::make_unique<SellMatrix>(A_);
+                sell_sparsity_ = A_.connectivity();
+            }
+            break;
+        default:
+            break;
+        }
     }
     //=============================================================================
     std::vector<real_t> NativeLinearSystem::residual_history() const
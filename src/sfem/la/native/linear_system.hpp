@@ -4,9 +4,25 @@
 #include <sfem/la/native/setval_utils.hpp>
 #include <sfem/la/native/sparse_matrix.hpp>
 #include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/bsr_matrix.hpp>
+#include <sfem/la/native/sell_matrix.hpp>
 
 namespace sfem::la
 {
+    /// @brief Matrix storage format used by the solver of a native linear system.
+    /// The matrix is always assembled in CSR format, and converted after assembly
+    enum class MatrixFormat
+    {
+        /// @brief Compressed sparse row (see SparseMatrix)
+        csr,
+
+        /// @brief Block CSR with padded column-major blocks (see BSRMatrix)
+        bsr,
+
+        /// @brief Sliced ELLPACK, for block size 1 (see SellMatrix)
+        sell
+    };
+
     class LinearSystem
     {
     public:
@@ -50,6 +66,14 @@ namespace sfem::la
         std::shared_ptr<LinearSolver> solver();
         std::shared_ptr<const LinearSolver> solver() const;
 
+        /// @brief Set the matrix format used by the solver
+        /// @note The default is MatrixFormat::csr. The converted matrix is created at the next
+        /// assembly (or solve), and its values are refreshed by assemble() and scale_diagonal()
+        void set_matrix_format(MatrixFormat format);
+
+        /// @brief Get the matrix format used by the solver
+        MatrixFormat matrix_format() const;
+
         void reset() override;
 
         MatSet lhs() override;
@@ -70,10 +94,23 @@ namespace sfem::la
         std::vector<real_t> residual_history() const override;
 
     private:
+        /// @brief Convert the matrix to the solver's format, or update the values
+        /// of the previous conversion
+        void update_converted_matrix();
+
         SparseMatrix A_;
 
         Vector b_;
 
         std::shared_ptr<LinearSolver> solver_;
+
+        MatrixFormat format_;
+
+        /// @brief Matrix in BSR format (if used)
+        std::unique_ptr<BSRMatrix> bsr_;
+
+        /// @brief Matrix in SELL format (if used), and the sparsity it was sliced for
+        std::unique_ptr<SellMatrix> sell_;
+        std::shared_ptr<const graph::Connectivity> sell_sparsity_;
     };
 }
\ No newline at end of file
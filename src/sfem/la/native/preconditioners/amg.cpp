@@ -0,0 +1,967 @@
+#include "amg.hpp"
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/parallel/scatterer.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/parallel/mpi.hpp>
+#include <sfem/base/error.hpp>
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace sfem::la
+{
+    /// @brief Rows of the prolongator, with global coarse column indices
+    struct ProlongatorRows
+    {
+        std::vector<int> offsets = {0};
+        std::vector<int> cols;
+        std::vector<real_t> values;
+    };
+    //=============================================================================
+    static real_t block_norm(const real_t *block, int bs2)
+    {
+        real_t sum = 0.0;
+        for (int k = 0; k < bs2; k++)
+        {
+            sum += block[k] * block[k];
+        }
+        return std::sqrt(sum);
+    }
+    //=============================================================================
+    static std::vector<real_t> compute_inv_diagonal(const SparseMatrix &A)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs2 = A.block_size() * A.block_size();
+        const auto diag_idxs = A.diagonal_idxs();
+        const auto &values = A.values();
+
+        std::vector<real_t> inv_diag(n_owned * bs2, 0.0);
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (diag_idxs[i] < 0)
+            {
+                SFEM_ERROR(std::format("Row {} has no diagonal entry\n", i));
+            }
+
+            std::span<const real_t> block(values.data() + diag_idxs[i] * bs2, bs2);
+            std::span<real_t> inv_block(inv_diag.data() + i * bs2, bs2);
+            const real_t det = utils::inv(A.block_size(), block, inv_block);
+            if (std::abs(det) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Singular diagonal block at row {}\n", i));
+            }
+        }
+        return inv_diag;
+    }
+    //=============================================================================
+    /// @brief Compute y = a * D^-1 x + b * y, for the owned rows
+    static void inv_diag_multiply(std::span<const real_t> inv_diag,
+                                  real_t a, const Vector &x,
+                                  real_t b, Vector &y)
+    {
+        const int n_owned = x.n_owned();
+        const int bs = x.block_size();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n_owned; i++)
+        {
+            const real_t *di = inv_diag.data() + i * bs * bs;
+            for (int k1 = 0; k1 < bs; k1++)
+            {
+                real_t sum = 0.0;
+                for (int k2 = 0; k2 < bs; k2++)
+                {
+                    sum += di[k1 * bs + k2] * xv[i * bs + k2];
+                }
+                yv[i * bs + k1] = (b == 0.0) ? a * sum : a * sum + b * yv[i * bs + k1];
+            }
+        }
+    }
+    //=============================================================================
+    /// @brief Compute the residual r = b - Ax
+    static void residual(const SparseMatrix &A, Vector &x, const Vector &b, Vector &r)
+    {
+        spmv_overlap(A, x, r);
+        axpbypc(1.0, -1.0, 0.0, b, r, r);
+    }
+    //=============================================================================
+    /// @brief Compute an upper bound for the spectral radius of D^-1 A,
+    /// i.e. the largest absolute row sum (Gershgorin's theorem)
+    static real_t spectral_radius_bound(const SparseMatrix &A, std::span<const real_t> inv_diag)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs = A.block_size();
+        const int bs2 = bs * bs;
+
+        std::vector<real_t> row_sums(bs);
+        real_t bound = 0.0;
+        for (int i = 0; i < n_owned; i++)
+        {
+            const real_t *di = inv_diag.data() + i * bs2;
+            std::fill(row_sums.begin(), row_sums.end(), 0.0);
+            auto [cols, values] = A.row_data(i);
+            for (std::size_t c = 0; c < cols.size(); c++)
+            {
+                const real_t *a_ij = values.data() + c * bs2;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        real_t sum = 0.0;
+                        for (int k3 = 0; k3 < bs; k3++)
+                        {
+                            sum += di[k1 * bs + k3] * a_ij[k3 * bs + k2];
+                        }
+                        row_sums[k1] += std::abs(sum);
+                    }
+                }
+            }
+            bound = std::max(bound, *std::max_element(row_sums.cbegin(), row_sums.cend()));
+        }
+
+        return mpi::reduce(bound, mpi::ReduceOperation::max);
+    }
+    //=============================================================================
+    /// @brief Aggregate the owned (block) rows of a matrix, based on the
+    /// strength of their connections with other owned rows
+    /// @return Number of aggregates
+    static int aggregate(const SparseMatrix &A, real_t threshold, std::vector<int> &agg)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs2 = A.block_size() * A.block_size();
+        const auto diag_idxs = A.diagonal_idxs();
+        const auto &values = A.values();
+
+        std::vector<real_t> diag_norm(n_owned);
+        for (int i = 0; i < n_owned; i++)
+        {
+            diag_norm[i] = block_norm(values.data() + diag_idxs[i] * bs2, bs2);
+        }
+
+        // Strong connections: |a_ij| > threshold * sqrt(|a_ii| |a_jj|)
+        std::vector<int> offsets(n_owned + 1, 0);
+        std::vector<int> strong;
+        std::vector<real_t> strength;
+        for (int i = 0; i < n_owned; i++)
+        {
+            auto [cols, row_values] = A.row_data(i);
+            for (std::size_t c = 0; c < cols.size(); c++)
+            {
+                const int j = cols[c];
+                if (j == i or j >= n_owned)
+                {
+                    continue;
+                }
+
+                const real_t a_ij = block_norm(row_values.data() + c * bs2, bs2);
+                if (a_ij > threshold * std::sqrt(diag_norm[i] * diag_norm[j]))
+                {
+                    strong.push_back(j);
+                    strength.push_back(a_ij / std::sqrt(diag_norm[i] * diag_norm[j]));
+                }
+            }
+            offsets[i + 1] = static_cast<int>(strong.size());
+        }
+
+        agg.assign(n_owned, -1);
+        int n_agg = 0;
+
+        // Phase 1: rows whose strong neighbours are all unaggregated form new aggregates
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (agg[i] >= 0)
+            {
+                continue;
+            }
+
+            bool free = true;
+            for (int p = offsets[i]; p < offsets[i + 1] and free; p++)
+            {
+                free = agg[strong[p]] < 0;
+            }
+
+            if (free)
+            {
+                agg[i] = n_agg;
+                for (int p = offsets[i]; p < offsets[i + 1]; p++)
+                {
+                    agg[strong[p]] = n_agg;
+                }
+                n_agg++;
+            }
+        }
+
+        // Phase 2: remaining rows join their most strongly connected aggregate
+        const std::vector<int> agg_phase1 = agg;
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (agg[i] >= 0)
+            {
+                continue;
+            }
+
+            real_t max_strength = 0.0;
+            for (int p = offsets[i]; p < offsets[i + 1]; p++)
+            {
+                if (agg_phase1[strong[p]] >= 0 and strength[p] > max_strength)
+                {
+                    max_strength = strength[p];
+                    agg[i] = agg_phase1[strong[p]];
+                }
+            }
+        }
+
+        // Phase 3: rows left over form aggregates with their unaggregated neighbours
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (agg[i] >= 0)
+            {
+                continue;
+            }
+
+            agg[i] = n_agg;
+            for (int p = offsets[i]; p < offsets[i + 1]; p++)
+            {
+                if (agg[strong[p]] < 0)
+                {
+                    agg[strong[p]] = n_agg;
+                }
+            }
+            n_agg++;
+        }
+
+        return n_agg;
+    }
+    //=============================================================================
+    /// @brief Compute the owned rows of the smoothed prolongator P = (I - omega D^-1 A) T,
+    /// where T is the tentative prolongator, i.e. T_ij = I if row i belongs to aggregate j
+    /// @param coarse_idxs Global aggregate index of each local (owned and ghost) row
+    static ProlongatorRows smoothed_prolongator(const SparseMatrix &A,
+                                                std::span<const real_t> inv_diag,
+                                                real_t omega,
+                                                std::span<const int> coarse_idxs)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs = A.block_size();
+        const int bs2 = bs * bs;
+
+        ProlongatorRows P;
+        std::vector<real_t> tmp(bs2);
+        for (int i = 0; i < n_owned; i++)
+        {
+            const int start = P.offsets.back();
+
+            // Block of column J in the current row, created if not present
+            auto block = [&](int J)
+            {
+                auto it = std::find(P.cols.begin() + start, P.cols.end(), J);
+                if (it == P.cols.end())
+                {
+                    P.cols.push_back(J);
+                    P.values.resize(P.values.size() + bs2, 0.0);
+                    return P.values.data() + (P.cols.size() - 1) * bs2;
+                }
+                return P.values.data() + std::distance(P.cols.begin(), it) * bs2;
+            };
+
+            // Tentative prolongator
+            real_t *t_ii = block(coarse_idxs[i]);
+            for (int k = 0; k < bs; k++)
+            {
+                t_ii[k * bs + k] += 1.0;
+            }
+
+            // Jacobi smoothing
+            std::span<const real_t> di(inv_diag.data() + i * bs2, bs2);
+            auto [cols, values] = A.row_data(i);
+            for (std::size_t c = 0; c < cols.size(); c++)
+            {
+                utils::matmult(bs, bs, bs, di, values.subspan(c * bs2, bs2), tmp);
+                real_t *p_ij = block(coarse_idxs[cols[c]]);
+                for (int k = 0; k < bs2; k++)
+                {
+                    p_ij[k] -= omega * tmp[k];
+                }
+            }
+
+            P.offsets.push_back(static_cast<int>(P.cols.size()));
+        }
+
+        return P;
+    }
+    //=============================================================================
+    /// @brief Get the prolongator rows of the ghost rows of an index map from their owners
+    static ProlongatorRows ghost_rows(const IndexMap &im, const ProlongatorRows &P, int bs2)
+    {
+        // Request the ghost rows from their owners
+        auto [requests, counts, displs] = mpi::send_to_dest<int>(im.ghost_idxs(), im.ghost_owners());
+
+        // Send the requested rows, in COO format
+        std::vector<int> send_rows;
+        std::vector<int> send_cols;
+        std::vector<int> send_dest;
+        std::vector<real_t> send_values;
+        for (int proc = 0; proc < mpi::n_procs(); proc++)
+        {
+            for (int k = displs[proc]; k < displs[proc] + counts[proc]; k++)
+            {
+                const int i = im.global_to_local(requests[k]);
+                for (int p = P.offsets[i]; p < P.offsets[i + 1]; p++)
+                {
+                    send_rows.push_back(requests[k]);
+                    send_cols.push_back(P.cols[p]);
+                    send_dest.push_back(proc);
+                    send_values.insert(send_values.end(),
+                                       P.values.cbegin() + p * bs2,
+                                       P.values.cbegin() + (p + 1) * bs2);
+                }
+            }
+        }
+        auto recv_rows = std::get<0>(mpi::send_to_dest<int>(send_rows, send_dest));
+        auto recv_cols = std::get<0>(mpi::send_to_dest<int>(send_cols, send_dest));
+        auto recv_values = std::get<0>(mpi::send_to_dest<real_t>(send_values, send_dest, bs2));
+        recv_rows = im.global_to_local(recv_rows);
+
+        // Convert to CSR, indexing the ghost rows from zero
+        const int n_owned = im.n_owned();
+        ProlongatorRows P_ghost;
+        P_ghost.offsets.assign(im.n_ghost() + 1, 0);
+        for (int row : recv_rows)
+        {
+            P_ghost.offsets[row - n_owned + 1]++;
+        }
+        std::inclusive_scan(P_ghost.offsets.cbegin(), P_ghost.offsets.cend(), P_ghost.offsets.begin());
+
+        P_ghost.cols.resize(recv_cols.size());
+        P_ghost.values.resize(recv_values.size());
+        std::vector<int> pos(P_ghost.offsets.cbegin(), P_ghost.offsets.cend() - 1);
+        for (std::size_t k = 0; k < recv_rows.size(); k++)
+        {
+            const int p = pos[recv_rows[k] - n_owned]++;
+            P_ghost.cols[p] = recv_cols[k];
+            std::copy(recv_values.cbegin() + k * bs2,
+                      recv_values.cbegin() + (k + 1) * bs2,
+                      P_ghost.values.begin() + p * bs2);
+        }
+
+        return P_ghost;
+    }
+    //=============================================================================
+    /// @brief Compute the coarse operator P^T A P
+    /// @param P Prolongator rows of the owned rows
+    /// @param P_ghost Prolongator rows of the ghost rows
+    /// @param coarse_offsets Range of global coarse indices owned by each process
+    static std::shared_ptr<const SparseMatrix>
+    galerkin_product(const SparseMatrix &A,
+                     const ProlongatorRows &P,
+                     const ProlongatorRows &P_ghost,
+                     std::span<const int> coarse_offsets)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs = A.block_size();
+        const int bs2 = bs * bs;
+        const int c_begin = coarse_offsets[mpi::rank()];
+        const int c_end = coarse_offsets[mpi::rank() + 1];
+        const long long n_coarse = coarse_offsets.back();
+
+        auto owner = [&coarse_offsets](int J)
+        {
+            return static_cast<int>(std::distance(coarse_offsets.begin(),
+                                                  std::upper_bound(coarse_offsets.begin(),
+                                                                   coarse_offsets.end(), J)) -
+                                    1);
+        };
+
+        // Compact numbering for the coarse indices of the local prolongator rows
+        std::unordered_map<int, int> compact;
+        std::vector<int> compact_to_global;
+        auto to_compact = [&](const std::vector<int> &cols)
+        {
+            std::vector<int> compact_cols(cols.size());
+            for (std::size_t k = 0; k < cols.size(); k++)
+            {
+                auto [it, inserted] = compact.try_emplace(cols[k], static_cast<int>(compact_to_global.size()));
+                if (inserted)
+                {
+                    compact_to_global.push_back(cols[k]);
+                }
+                compact_cols[k] = it->second;
+            }
+            return compact_cols;
+        };
+        const auto P_cols = to_compact(P.cols);
+        const auto P_ghost_cols = to_compact(P_ghost.cols);
+
+        // Coarse matrix entries in COO format, accumulated by (global) row and column
+        std::unordered_map<long long, int> entry_idx;
+        std::vector<int> rows;
+        std::vector<int> cols;
+        std::vector<real_t> values;
+        auto entry = [&](int I, int J)
+        {
+            auto [it, inserted] = entry_idx.try_emplace(I * n_coarse + J, static_cast<int>(rows.size()));
+            if (inserted)
+            {
+                rows.push_back(I);
+                cols.push_back(J);
+                values.resize(values.size() + bs2, 0.0);
+            }
+            return values.data() + it->second * bs2;
+        };
+
+        std::vector<int> marker(compact_to_global.size(), -1);
+        std::vector<int> touched;
+        std::vector<real_t> ap;
+        for (int i = 0; i < n_owned; i++)
+        {
+            // Row i of AP
+            touched.clear();
+            auto [a_cols, a_values] = A.row_data(i);
+            for (std::size_t c = 0; c < a_cols.size(); c++)
+            {
+                const int j = a_cols[c];
+                const bool is_owned = j < n_owned;
+                const auto &Pj = is_owned ? P : P_ghost;
+                const auto &Pj_cols = is_owned ? P_cols : P_ghost_cols;
+                const int row = is_owned ? j : j - n_owned;
+                const real_t *a_ij = a_values.data() + c * bs2;
+
+                for (int q = Pj.offsets[row]; q < Pj.offsets[row + 1]; q++)
+                {
+                    const int J = Pj_cols[q];
+                    if (marker[J] < 0)
+                    {
+                        marker[J] = static_cast<int>(touched.size());
+                        touched.push_back(J);
+                        ap.resize(std::max(ap.size(), touched.size() * bs2));
+                        std::fill(ap.begin() + marker[J] * bs2, ap.begin() + (marker[J] + 1) * bs2, 0.0);
+                    }
+
+                    const real_t *p_jJ = Pj.values.data() + q * bs2;
+                    real_t *ap_iJ = ap.data() + marker[J] * bs2;
+                    for (int k1 = 0; k1 < bs; k1++)
+                    {
+                        for (int k2 = 0; k2 < bs; k2++)
+                        {
+                            for (int k3 = 0; k3 < bs; k3++)
+                            {
+                                ap_iJ[k1 * bs + k2] += a_ij[k1 * bs + k3] * p_jJ[k3 * bs + k2];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Contributions of row i to P^T AP
+            for (int q = P.offsets[i]; q < P.offsets[i + 1]; q++)
+            {
+                const real_t *p_iI = P.values.data() + q * bs2;
+                for (std::size_t t = 0; t < touched.size(); t++)
+                {
+                    const real_t *ap_iJ = ap.data() + t * bs2;
+                    real_t *c_IJ = entry(P.cols[q], compact_to_global[touched[t]]);
+                    for (int k1 = 0; k1 < bs; k1++)
+                    {
+                        for (int k2 = 0; k2 < bs; k2++)
+                        {
+                            for (int k3 = 0; k3 < bs; k3++)
+                            {
+                                c_IJ[k1 * bs + k2] += p_iI[k3 * bs + k1] * ap_iJ[k3 * bs + k2];
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (int J : touched)
+            {
+                marker[J] = -1;
+            }
+        }
+
+        // Send the entries of non-owned coarse rows to their owners
+        std::vector<int> send_rows;
+        std::vector<int> send_cols;
+        std::vector<int> send_dest;
+        std::vector<real_t> send_values;
+        for (std::size_t k = 0; k < rows.size(); k++)
+        {
+            if (rows[k] < c_begin or rows[k] >= c_end)
+            {
+                send_rows.push_back(rows[k]);
+                send_cols.push_back(cols[k]);
+                send_dest.push_back(owner(rows[k]));
+                send_values.insert(send_values.end(),
+                                   values.cbegin() + k * bs2,
+                                   values.cbegin() + (k + 1) * bs2);
+            }
+        }
+        auto recv_rows = std::get<0>(mpi::send_to_dest<int>(send_rows, send_dest));
+        auto recv_cols = std::get<0>(mpi::send_to_dest<int>(send_cols, send_dest));
+        auto recv_values = std::get<0>(mpi::send_to_dest<real_t>(send_values, send_dest, bs2));
+        for (std::size_t k = 0; k < recv_rows.size(); k++)
+        {
+            real_t *c_IJ = entry(recv_rows[k], recv_cols[k]);
+            for (int k1 = 0; k1 < bs2; k1++)
+            {
+                c_IJ[k1] += recv_values[k * bs2 + k1];
+            }
+        }
+
+        // Coarse index map: owned coarse indices, followed by the (sorted) ghost
+        // coarse indices referenced by the owned rows of P^T AP and P
+        std::vector<int> ghosts;
+        for (std::size_t k = 0; k < rows.size(); k++)
+        {
+            if (rows[k] >= c_begin and rows[k] < c_end and (cols[k] < c_begin or cols[k] >= c_end))
+            {
+                ghosts.push_back(cols[k]);
+            }
+        }
+        for (int J : P.cols)
+        {
+            if (J < c_begin or J >= c_end)
+            {
+                ghosts.push_back(J);
+            }
+        }
+        std::sort(ghosts.begin(), ghosts.end());
+        ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+
+        std::vector<int> ghost_owners(ghosts.size());
+        std::transform(ghosts.cbegin(), ghosts.cend(), ghost_owners.begin(), owner);
+        std::vector<int> global_idxs(c_end - c_begin);
+        std::iota(global_idxs.begin(), global_idxs.end(), c_begin);
+        global_idxs.insert(global_idxs.end(), ghosts.cbegin(), ghosts.cend());
+        auto coarse_im = std::make_shared<const IndexMap>(std::move(global_idxs), std::move(ghost_owners));
+
+        // Owned entries in CSR format, sorted by (local) row and column
+        std::vector<int> owned_entries;
+        for (std::size_t k = 0; k < rows.size(); k++)
+        {
+            if (rows[k] >= c_begin and rows[k] < c_end)
+            {
+                rows[k] -= c_begin;
+                cols[k] = coarse_im->global_to_local(cols[k]);
+                owned_entries.push_back(static_cast<int>(k));
+            }
+        }
+        std::sort(owned_entries.begin(), owned_entries.end(), [&](int a, int b)
+                  { return std::pair(rows[a], cols[a]) < std::pair(rows[b], cols[b]); });
+
+        std::vector<int> offsets(coarse_im->n_local() + 1, 0);
+        std::vector<int> array(owned_entries.size());
+        for (std::size_t k = 0; k < owned_entries.size(); k++)
+        {
+            offsets[rows[owned_entries[k]] + 1]++;
+            array[k] = cols[owned_entries[k]];
+        }
+        std::inclusive_scan(offsets.cbegin(), offsets.cend(), offsets.begin());
+
+        auto row_to_col = std::make_shared<const graph::Connectivity>(std::move(offsets), std::move(array));
+        auto A_coarse = std::make_shared<SparseMatrix>(row_to_col, coarse_im, coarse_im, bs);
+        auto &coarse_values = A_coarse->values();
+        for (std::size_t k = 0; k < owned_entries.size(); k++)
+        {
+            std::copy(values.cbegin() + owned_entries[k] * bs2,
+                      values.cbegin() + (owned_entries[k] + 1) * bs2,
+                      coarse_values.begin() + k * bs2);
+        }
+
+        return A_coarse;
+    }
+    //=============================================================================
+    /// @brief In-place LU factorization with partial pivoting of a dense (row-major) matrix.
+    /// Zero pivots, e.g. for singular systems with a pure Neumann boundary,
+    /// are replaced by one, so that the solve yields a particular solution
+    static void lu_factor(int n, std::span<real_t> a, std::span<int> piv)
+    {
+        real_t max_abs = 0.0;
+        for (real_t v : a)
+        {
+            max_abs = std::max(max_abs, std::abs(v));
+        }
+        const real_t tol = n * std::numeric_limits<real_t>::epsilon() * max_abs;
+
+        for (int k = 0; k < n; k++)
+        {
+            int p = k;
+            for (int i = k + 1; i < n; i++)
+            {
+                if (std::abs(a[i * n + k]) > std::abs(a[p * n + k]))
+                {
+                    p = i;
+                }
+            }
+            piv[k] = p;
+            if (p != k)
+            {
+                std::swap_ranges(a.begin() + k * n, a.begin() + (k + 1) * n, a.begin() + p * n);
+            }
+
+            if (std::abs(a[k * n + k]) <= tol)
+            {
+                a[k * n + k] = 1.0;
+                for (int i = k + 1; i < n; i++)
+                {
+                    a[i * n + k] = 0.0;
+                }
+                continue;
+            }
+
+            for (int i = k + 1; i < n; i++)
+            {
+                const real_t l = a[i * n + k] / a[k * n + k];
+                a[i * n + k] = l;
+                for (int j = k + 1; j < n; j++)
+                {
+                    a[i * n + j] -= l * a[k * n + j];
+                }
+            }
+        }
+    }
+    //=============================================================================
+    /// @brief Solve a linear system with a matrix factorized by lu_factor (in-place)
+    static void lu_solve(int n, std::span<const real_t> lu, std::span<const int> piv, std::span<real_t> b)
+    {
+        for (int k = 0; k < n; k++)
+        {
+            std::swap(b[k], b[piv[k]]);
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < i; j++)
+            {
+                b[i] -= lu[i * n + j] * b[j];
+            }
+        }
+
+        for (int i = n - 1; i >= 0; i--)
+        {
+            for (int j = i + 1; j < n; j++)
+            {
+                b[i] -= lu[i * n + j] * b[j];
+            }
+            b[i] /= lu[i * n + i];
+        }
+    }
+    //=============================================================================
+    AMG::AMG(AMGOptions options)
+        : Preconditioner("AMG"),
+          options_(options),
+          direct_coarse_(false),
+          n_coarse_(0),
+          coarse_offset_(0)
+    {
+    }
+    //=============================================================================
+    int AMG::n_levels() const
+    {
+        return static_cast<int>(levels_.size());
+    }
+    //=============================================================================
+    const SparseMatrix &AMG::level_matrix(int level) const
+    {
+        SFEM_CHECK_INDEX(level, n_levels());
+        return *levels_[level].A;
+    }
+    //=============================================================================
+    void AMG::setup(const SparseMatrix &A)
+    {
+        const auto [row_im, col_im] = A.index_maps();
+        if (row_im != col_im)
+        {
+            SFEM_ERROR("AMG requires identical row and column index maps\n");
+        }
+
+        levels_.clear();
+        levels_.emplace_back();
+        levels_.back().A = &A;
+
+        while (true)
+        {
+            Level &level = levels_.back();
+            setup_level(level);
+
+            const auto im = level.A->index_maps()[0];
+            const int n_global = im->n_global();
+            if (n_global <= options_.coarse_size or n_levels() >= options_.max_levels)
+            {
+                break;
+            }
+
+            // Aggregate the owned rows and number the aggregates globally
+            std::vector<int> agg;
+            const int n_agg = aggregate(*level.A, options_.threshold, agg);
+            const auto n_aggs = mpi::all_gather<int>({&n_agg, 1});
+            std::vector<int> coarse_offsets(n_aggs.size() + 1, 0);
+            std::inclusive_scan(n_aggs.cbegin(), n_aggs.cend(), coarse_offsets.begin() + 1);
+            if (coarse_offsets.back() == 0 or coarse_offsets.back() >= n_global)
+            {
+                break;
+            }
+
+            // Global aggregate index of each local row
+            std::vector<int> coarse_idxs(im->n_local(), 0);
+            for (int i = 0; i < im->n_owned(); i++)
+            {
+                coarse_idxs[i] = coarse_offsets[mpi::rank()] + agg[i];
+            }
+            Scatterer<int>(im).forward(coarse_idxs, 1, InsertOp{});
+
+            // Smoothed prolongator and Galerkin coarse operator
+            const int bs2 = level.A->block_size() * level.A->block_size();
+            const real_t omega = 4.0 / (3.0 * level.lambda_max);
+            auto P = smoothed_prolongator(*level.A, level.inv_diag, omega, coarse_idxs);
+            auto P_ghost = ghost_rows(*im, P, bs2);
+            auto A_coarse = galerkin_product(*level.A, P, P_ghost, coarse_offsets);
+
+            level.P.offsets = std::move(P.offsets);
+            level.P.cols = A_coarse->index_maps()[1]->global_to_local(P.cols);
+            level.P.values = std::move(P.values);
+
+            levels_.emplace_back();
+            levels_.back().A = A_coarse.get();
+            levels_.back().A_coarse = A_coarse;
+        }
+
+        setup_coarse_solver();
+    }
+    //=============================================================================
+    void AMG::apply(const Vector &x, Vector &y) const
+    {
+        const Level &fine = levels_.front();
+        SFEM_CHECK_SIZES(fine.b->n_owned(), x.n_owned());
+        SFEM_CHECK_SIZES(fine.b->n_owned(), y.n_owned());
+        SFEM_CHECK_SIZES(fine.b->block_size(), x.block_size());
+
+        copy(x, *fine.b);
+        cycle(0);
+        copy(*fine.x, y);
+    }
+    //=============================================================================
+    void AMG::setup_level(Level &level) const
+    {
+        const auto im = level.A->index_maps()[0];
+        const int bs = level.A->block_size();
+
+        level.b = std::make_shared<Vector>(im, bs);
+        level.x = std::make_shared<Vector>(im, bs);
+        level.r = std::make_shared<Vector>(im, bs);
+        level.d = std::make_shared<Vector>(im, bs);
+
+        level.inv_diag = compute_inv_diagonal(*level.A);
+        level.lambda_max = spectral_radius_bound(*level.A, level.inv_diag);
+    }
+    //=============================================================================
+    void AMG::setup_coarse_solver()
+    {
+        const Level &coarse = levels_.back();
+        const auto im = coarse.A->index_maps()[0];
+        const int bs = coarse.A->block_size();
+        const int bs2 = bs * bs;
+        const int n_owned = im->n_owned();
+
+        const int n_global = im->n_global();
+        direct_coarse_ = n_global <= options_.coarse_size;
+        if (!direct_coarse_)
+        {
+            log_msg(std::format("AMG coarsest level has {} rows, smoothing is used instead of a direct solve\n",
+                                n_global),
+                    true, LogLevel::warning);
+            coarse_lu_.clear();
+            coarse_piv_.clear();
+            return;
+        }
+
+        // Position of each row in the coarse system, i.e. the owned rows
+        // of all processes in rank order
+        coarse_offset_ = im->global_offset();
+        const auto global_idxs = mpi::all_gather<int>(im->owned_idxs());
+        std::unordered_map<int, int> position;
+        for (std::size_t k = 0; k < global_idxs.size(); k++)
+        {
+            position[global_idxs[k]] = static_cast<int>(k);
+        }
+
+        // Gather the coarse matrix to all processes, in COO format
+        std::vector<int> rows;
+        std::vector<int> cols;
+        std::vector<real_t> values;
+        for (int i = 0; i < n_owned; i++)
+        {
+            auto [row_cols, row_values] = coarse.A->row_data(i);
+            for (int col : row_cols)
+            {
+                rows.push_back(coarse_offset_ + i);
+                cols.push_back(position.at(im->local_to_global(col)));
+            }
+            values.insert(values.end(), row_values.begin(), row_values.end());
+        }
+        rows = mpi::all_gather<int>(rows);
+        cols = mpi::all_gather<int>(cols);
+        values = mpi::all_gather<real_t>(values);
+
+        // Dense matrix and its LU factorization
+        n_coarse_ = static_cast<int>(global_idxs.size()) * bs;
+        coarse_lu_.assign(n_coarse_ * n_coarse_, 0.0);
+        coarse_piv_.resize(n_coarse_);
+        for (std::size_t k = 0; k < rows.size(); k++)
+        {
+            for (int k1 = 0; k1 < bs; k1++)
+            {
+                for (int k2 = 0; k2 < bs; k2++)
+                {
+                    coarse_lu_[(rows[k] * bs + k1) * n_coarse_ + cols[k] * bs + k2] += values[k * bs2 + k1 * bs + k2];
+                }
+            }
+        }
+        lu_factor(n_coarse_, coarse_lu_, coarse_piv_);
+    }
+    //=============================================================================
+    void AMG::smooth(const Level &level, bool zero_guess) const
+    {
+        const SparseMatrix &A = *level.A;
+        Vector &b = *level.b;
+        Vector &x = *level.x;
+        Vector &r = *level.r;
+        Vector &d = *level.d;
+
+        if (options_.smoother == AMGSmoother::jacobi)
+        {
+            for (int sweep = 0; sweep < options_.n_smooth; sweep++)
+            {
+                if (zero_guess and sweep == 0)
+                {
+                    inv_diag_multiply(level.inv_diag, options_.jacobi_omega, b, 0.0, x);
+                }
+                else
+                {
+                    residual(A, x, b, r);
+                    inv_diag_multiply(level.inv_diag, options_.jacobi_omega, r, 1.0, x);
+                }
+            }
+            return;
+        }
+
+        // Chebyshev iteration on [lambda_max / ratio, lambda_max]
+        const real_t upper = level.lambda_max;
+        const real_t lower = upper / options_.chebyshev_ratio;
+        const real_t theta = 0.5 * (upper + lower);
+        const real_t delta = 0.5 * (upper - lower);
+        const real_t sigma = theta / delta;
+        real_t rho = 1.0 / sigma;
+
+        if (zero_guess)
+        {
+            inv_diag_multiply(level.inv_diag, 1.0 / theta, b, 0.0, d);
+            copy(d, x);
+        }
+        else
+        {
+            residual(A, x, b, r);
+            inv_diag_multiply(level.inv_diag, 1.0 / theta, r, 0.0, d);
+            axpy(1.0, d, x);
+        }
+
+        for (int k = 1; k < options_.n_smooth; k++)
+        {
+            const real_t rho_new = 1.0 / (2.0 * sigma - rho);
+            residual(A, x, b, r);
+            inv_diag_multiply(level.inv_diag, 2.0 * rho_new / delta, r, rho_new * rho, d);
+            axpy(1.0, d, x);
+            rho = rho_new;
+        }
+    }
+    //=============================================================================
+    void AMG::coarse_solve(const Level &level) const
+    {
+        if (!direct_coarse_)
+        {
+            smooth(level, true);
+            smooth(level, false);
+            return;
+        }
+
+        const int n_owned = level.b->n_owned() * level.b->block_size();
+        auto sol = mpi::all_gather<real_t>({level.b->values().data(), static_cast<std::size_t>(n_owned)});
+        lu_solve(n_coarse_, coarse_lu_, coarse_piv_, sol);
+        std::copy(sol.cbegin() + coarse_offset_ * level.b->block_size(),
+                  sol.cbegin() + coarse_offset_ * level.b->block_size() + n_owned,
+                  level.x->values().begin());
+    }
+    //=============================================================================
+    void AMG::cycle(int l) const
+    {
+        const Level &level = levels_[l];
+        if (l == n_levels() - 1)
+        {
+            coarse_solve(level);
+            return;
+        }
+
+        const Level &coarse = levels_[l + 1];
+        const int n_owned = level.b->n_owned();
+        const int bs = level.b->block_size();
+        const int bs2 = bs * bs;
+        const auto &P = level.P;
+
+        // Pre-smoothing and residual
+        smooth(level, true);
+        residual(*level.A, *level.x, *level.b, *level.r);
+
+        // Restriction: b_c = P^T r
+        const real_t *rv = level.r->values().data();
+        real_t *bcv = coarse.b->values().data();
+        coarse.b->set_all(0.0);
+        for (int i = 0; i < n_owned; i++)
+        {
+            for (int p = P.offsets[i]; p < P.offsets[i + 1]; p++)
+            {
+                const real_t *p_iJ = P.values.data() + p * bs2;
+                real_t *bc = bcv + P.cols[p] * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        bc[k2] += p_iJ[k1 * bs + k2] * rv[i * bs + k1];
+                    }
+                }
+            }
+        }
+        coarse.b->assemble();
+
+        // Coarse-level correction
+        cycle(l + 1);
+
+        // Prolongation: x += P x_c
+        coarse.x->update_ghosts();
+        const real_t *xcv = coarse.x->values().data();
+        real_t *xv = level.x->values().data();
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n_owned; i++)
+        {
+            for (int p = P.offsets[i]; p < P.offsets[i + 1]; p++)
+            {
+                const real_t *p_iJ = P.values.data() + p * bs2;
+                const real_t *xc = xcv + P.cols[p] * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        xv[i * bs + k1] += p_iJ[k1 * bs + k2] * xc[k2];
+                    }
+                }
+            }
+        }
+
+        // Post-smoothing
+        smooth(level, false);
+    }
+}
\ No newline at end of file
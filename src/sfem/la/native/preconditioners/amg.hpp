@@ -0,0 +1,142 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+
+namespace sfem::la
+{
+    /// @brief Smoother used by the AMG preconditioner
+    enum class AMGSmoother
+    {
+        jacobi,
+        chebyshev
+    };
+
+    /// @brief Options for the AMG preconditioner
+    struct AMGOptions
+    {
+        /// @brief Maximum number of levels
+        int max_levels = 10;
+
+        /// @brief Global number of (block) rows below which coarsening stops.
+        /// The coarsest level is solved directly if it does not exceed this size
+        int coarse_size = 300;
+
+        /// @brief Strength-of-connection threshold for aggregation
+        real_t threshold = 0.08;
+
+        /// @brief Smoother type
+        AMGSmoother smoother = AMGSmoother::chebyshev;
+
+        /// @brief Number of pre- and post-smoothing sweeps (Jacobi)
+        /// or polynomial degree (Chebyshev)
+        int n_smooth = 2;
+
+        /// @brief Damping factor of the Jacobi smoother
+        real_t jacobi_omega = 2.0 / 3.0;
+
+        /// @brief Ratio of the largest to the smallest eigenvalue of D^-1 A
+        /// targeted by the Chebyshev smoother
+        real_t chebyshev_ratio = 30.0;
+    };
+
+    /// @brief Smoothed-aggregation algebraic multigrid preconditioner (V-cycle).
+    ///
+    /// Each process aggregates its owned rows independently (uncoupled aggregation),
+    /// based on the strength of the connections between (block) rows. The tentative
+    /// prolongator maps each aggregate to the identity block, i.e. the near-nullspace
+    /// is piecewise constant per component, and is smoothed with one step of damped
+    /// (block) Jacobi. Coarse operators are formed by the Galerkin product P^T A P, and
+    /// the coarsest level is gathered to all processes and solved with a dense LU.
+    class AMG : public Preconditioner
+    {
+    public:
+        /// @brief Create an AMG preconditioner
+        /// @param options Options
+        AMG(AMGOptions options = {});
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+        /// @brief Get the number of levels
+        int n_levels() const;
+
+        /// @brief Get the operator of a given level
+        const SparseMatrix &level_matrix(int level) const;
+
+    private:
+        /// @brief Prolongator from the next coarser level, in block CSR format.
+        /// Rows are the owned rows of the level, columns are local
+        /// (owned and ghost) indices of the next coarser level
+        struct Prolongator
+        {
+            std::vector<int> offsets;
+            std::vector<int> cols;
+            std::vector<real_t> values;
+        };
+
+        /// @brief Multigrid level
+        struct Level
+        {
+            /// @brief Operator
+            const SparseMatrix *A = nullptr;
+
+            /// @brief Operator storage (coarse levels only)
+            std::shared_ptr<const SparseMatrix> A_coarse;
+
+            /// @brief Prolongator from the next coarser level
+            Prolongator P;
+
+            /// @brief Inverse diagonal blocks of the owned rows (row-major)
+            std::vector<real_t> inv_diag;
+
+            /// @brief Upper bound for the largest eigenvalue of D^-1 A
+            real_t lambda_max = 1.0;
+
+            /// @brief Work vectors: right-hand side, solution, residual, update
+            std::shared_ptr<Vector> b;
+            std::shared_ptr<Vector> x;
+            std::shared_ptr<Vector> r;
+            std::shared_ptr<Vector> d;
+        };
+
+        /// @brief Set up the smoother and work vectors of a level
+        void setup_level(Level &level) const;
+
+        /// @brief Set up the direct solver for the coarsest level
+        void setup_coarse_solver();
+
+        /// @brief Smooth the solution of a level
+        /// @param zero_guess Whether the current solution is zero
+        void smooth(const Level &level, bool zero_guess) const;
+
+        /// @brief Solve the coarsest level
+        void coarse_solve(const Level &level) const;
+
+        /// @brief Perform a V-cycle starting from a given level
+        void cycle(int level) const;
+
+        /// @brief Options
+        AMGOptions options_;
+
+        /// @brief Levels, from finest to coarsest
+        std::vector<Level> levels_;
+
+        /// @brief Whether the coarsest level is solved directly
+        bool direct_coarse_;
+
+        /// @brief Coarse system size (global)
+        int n_coarse_;
+
+        /// @brief Offset of this process' owned values in the coarse system
+        int coarse_offset_;
+
+        /// @brief LU factors of the coarse matrix (row-major) and pivots
+        std::vector<real_t> coarse_lu_;
+        std::vector<int> coarse_piv_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "block_gauss_seidel.hpp"
+#include <sfem/la/native/bsr_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
+#include <sfem/graph/coloring.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <format>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Update a row: y_i = D_i^-1 * (x_i - sum_{j != i} M_ij * y_j).
+    /// BS is the block size, or 0 if it is only known at runtime (in which case acc and
+    /// tmp are scratch arrays with at least bsr_leading_dim(M.bs) values).
+    /// T is the storage type of the blocks, the update is computed in working precision
+    template <int BS, typename T>
+    static void update_row(const LocalMatrix &M,
+                           const T *blocks,
+                           const T *inv_diag,
+                           int row,
+                           const real_t *x,
+                           real_t *y,
+                           real_t *acc,
+                           real_t *tmp)
+    {
+        if constexpr (BS > 0)
+        {
+            constexpr int LD = bsr_leading_dim(BS);
+            std::array<real_t, LD> r{};
+            std::copy_n(x + row * BS, BS, r.begin());
+            for (int p = M.offsets[row]; p < M.offsets[row + 1]; p++)
+            {
+                if (p == M.diag[row])
+                {
+                    continue;
+                }
+                const T *mp = blocks + p * BS * LD;
+                const real_t *yj = y + M.cols[p] * BS;
+                for (int k2 = 0; k2 < BS; k2++)
+                {
+                    const real_t yk = yj[k2];
+                    SFEM_OMP(simd)
+                    for (int k1 = 0; k1 < LD; k1++)
+                    {
+                        r[k1] -= static_cast<real_t>(mp[k2 * LD + k1]) * yk;
+                    }
+                }
+            }
+
+            std::array<real_t, LD> yi{};
+            const T *di = inv_diag + row * BS * LD;
+            for (int k2 = 0; k2 < BS; k2++)
+            {
+                const real_t rk = r[k2];
+                SFEM_OMP(simd)
+                for (int k1 = 0; k1 < LD; k1++)
+                {
+                    yi[k1] += static_cast<real_t>(di[k2 * LD + k1]) * rk;
+                }
+            }
+            std::copy_n(yi.cbegin(), BS, y + row * BS);
+        }
+        else
+        {
+            const int bs = M.bs;
+            const int ld = bsr_leading_dim(bs);
+            std::copy_n(x + row * bs, bs, acc);
+            for (int p = M.offsets[row]; p < M.offsets[row + 1]; p++)
+            {
+                if (p == M.diag[row])
+                {
+                    continue;
+                }
+                const T *mp = blocks + p * bs * ld;
+                const real_t *yj = y + M.cols[p] * bs;
+                for (int k2 = 0; k2 < bs; k2++)
+                {
+                    for (int k1 = 0; k1 < bs; k1++)
+                    {
+                        acc[k1] -= static_cast<real_t>(mp[k2 * ld + k1]) * yj[k2];
+                    }
+                }
+            }
+
+            const T *di = inv_diag + row * bs * ld;
+            std::fill_n(tmp, bs, 0.0);
+            for (int k2 = 0; k2 < bs; k2++)
+            {
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    tmp[k1] += static_cast<real_t>(di[k2 * ld + k1]) * acc[k2];
+                }
+            }
+            std::copy_n(tmp, bs, y + row * bs);
+        }
+    }
+    //=============================================================================
+    BlockGaussSeidel::BlockGaussSeidel(int n_sweeps, bool single_precision)
+        : Preconditioner("BlockGaussSeidel"),
+          n_sweeps_(n_sweeps),
+          single_precision_(single_precision)
+    {
+        if (n_sweeps_ < 1)
+        {
+            SFEM_ERROR(std::format("Invalid number of Gauss-Seidel sweeps: {}\n", n_sweeps_));
+        }
+    }
+    //=============================================================================
+    void BlockGaussSeidel::setup(const SparseMatrix &A)
+    {
+        local_ = extract_local_matrix(A);
+        const int bs = local_.bs;
+        const int ld = bsr_leading_dim(bs);
+
+        // Pack the blocks and the inverse diagonal blocks
+        const int n_blocks = local_.offsets.back();
+        blocks_.resize(n_blocks * bs * ld);
+        pack_blocks(bs, n_blocks, local_.values.data(), blocks_.data());
+
+        const auto inv_diag = invert_diagonal_blocks(local_);
+        inv_diag_.resize(local_.n_rows * bs * ld);
+        pack_blocks(bs, local_.n_rows, inv_diag.data(), inv_diag_.data());
+
+        // The (row-major) values are no longer needed
+        local_.values = {};
+
+        // Round the packed blocks to single precision
+        if (single_precision_)
+        {
+            blocks_sp_.assign(blocks_.cbegin(), blocks_.cend());
+            inv_diag_sp_.assign(inv_diag_.cbegin(), inv_diag_.cend());
+            blocks_ = {};
+            inv_diag_ = {};
+        }
+
+        // Rows of the same color are not coupled, i.e. the row adjacency graph
+        // is colored (distance-1), with the off-diagonal blocks as edges
+        const graph::Connectivity row_to_col(std::vector<int>(local_.offsets), std::vector<int>(local_.cols));
+        colors_ = graph::greedy_graph_coloring(row_to_col);
+    }
+    //=============================================================================
+    void BlockGaussSeidel::apply(const Vector &x, Vector &y) const
+    {
+        SFEM_CHECK_SIZES(local_.bs, x.block_size());
+        SFEM_CHECK_SIZES(local_.bs, y.block_size());
+        SFEM_CHECK_SIZES(local_.n_rows, x.n_owned());
+        SFEM_CHECK_SIZES(local_.n_rows, y.n_owned());
+
+        const int bs = local_.bs;
+        const int n_colors = colors_.n_primary();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+        std::fill_n(yv, local_.n_rows * bs, 0.0);
+
+        // Perform the sweeps with the blocks stored as T
+        auto sweep = [&]<typename T>(const T *blocks, const T *inv_diag)
+        {
+            dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                                {
+                                    SFEM_OMP(parallel)
+                                    {
+                                        std::vector<real_t> acc(bsr_leading_dim(bs));
+                                        std::vector<real_t> tmp(bsr_leading_dim(bs));
+                                        for (int s = 0; s < 2 * n_sweeps_ * n_colors; s++)
+                                        {
+                                            // Colors in forward order, then in reverse order
+                                            const int cs = s % (2 * n_colors);
+                                            const int color = cs < n_colors ? cs : 2 * n_colors - 1 - cs;
+                                            const auto rows = colors_.links(color);
+                                            const int n_rows = static_cast<int>(rows.size());
+                                            SFEM_OMP(for)
+                                            for (int ii = 0; ii < n_rows; ii++)
+                                            {
+                                                update_row<BS>(local_, blocks, inv_diag,
+                                                               rows[ii], xv, yv, acc.data(), tmp.data());
+                                            }
+                                        }
+                                    } });
+        };
+
+        if (single_precision_)
+        {
+            sweep(blocks_sp_.data(), inv_diag_sp_.data());
+        }
+        else
+        {
+            sweep(blocks_.data(), inv_diag_.data());
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/preconditioners/local_matrix.hpp>
+
+namespace sfem::la
+{
+    /// @brief Multicolor symmetric block Gauss-Seidel preconditioner, applied to the rank-local
+    /// part of the matrix (block-Jacobi across processes).
+    ///
+    /// The rows are colored so that no two rows of the same color are coupled (i.e. A_ij = 0
+    /// and A_ji = 0), thus the rows of each color are updated in parallel. Each application
+    /// performs a number of symmetric sweeps (colors in forward, then in reverse order),
+    /// starting from a zero guess.
+    /// The blocks are stored in padded column-major layout (see BSRMatrix), so that the block
+    /// updates vectorize. Optionally, they are stored in single precision, which halves the
+    /// memory traffic of each sweep, while the vectors remain in working precision
+    class BlockGaussSeidel : public Preconditioner
+    {
+    public:
+        /// @brief Create a BlockGaussSeidel preconditioner
+        /// @param n_sweeps Number of symmetric sweeps
+        /// @param single_precision Whether to store the blocks in single precision
+        BlockGaussSeidel(int n_sweeps = 1, bool single_precision = false);
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+    private:
+        /// @brief Number of symmetric sweeps
+        int n_sweeps_;
+
+        /// @brief Whether to store the blocks in single precision
+        bool single_precision_;
+
+        /// @brief Rank-local part of the matrix
+        /// @note Its values are stored in blocks_ (or blocks_sp_)
+        LocalMatrix local_;
+
+        /// @brief Blocks of the local matrix (padded column-major)
+        std::vector<real_t> blocks_;
+
+        /// @brief Inverse diagonal blocks (padded column-major)
+        std::vector<real_t> inv_diag_;
+
+        /// @brief Blocks and inverse diagonal blocks, in single precision
+        std::vector<float> blocks_sp_;
+        std::vector<float> inv_diag_sp_;
+
+        /// @brief Color-to-row connectivity
+        graph::Connectivity colors_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "chebyshev.hpp"
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <cmath>
+#include <limits>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Compute y = a * D^-1 x + b * y, for the owned values
+    static void inv_diag_multiply(std::span<const real_t> inv_diag,
+                                  real_t a, const Vector &x,
+                                  real_t b, Vector &y)
+    {
+        const int n = static_cast<int>(inv_diag.size());
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n; i++)
+        {
+            yv[i] = (b == 0.0) ? a * inv_diag[i] * xv[i] : a * inv_diag[i] * xv[i] + b * yv[i];
+        }
+    }
+    //=============================================================================
+    Chebyshev::Chebyshev(ChebyshevOptions options)
+        : Preconditioner("Chebyshev"),
+          options_(options),
+          A_(nullptr),
+          lambda_max_(1.0)
+    {
+        if (options_.degree < 1)
+        {
+            SFEM_ERROR(std::format("Invalid Chebyshev polynomial degree {} (<1)\n", options_.degree));
+        }
+        if (options_.ratio <= 1)
+        {
+            SFEM_ERROR(std::format("Invalid Chebyshev eigenvalue ratio {} (<=1)\n", options_.ratio));
+        }
+    }
+    //=============================================================================
+    void Chebyshev::setup(const SparseMatrix &A)
+    {
+        matrix_op_ = std::make_shared<MatrixOperator>(A);
+        setup_operator(*matrix_op_);
+    }
+    //=============================================================================
+    void Chebyshev::setup_matrix_free(const LinearOperator &A)
+    {
+        matrix_op_.reset();
+        setup_operator(A);
+    }
+    //=============================================================================
+    void Chebyshev::setup_operator(const LinearOperator &A)
+    {
+        A_ = &A;
+        const auto im = A.index_map();
+        const int bs = A.block_size();
+
+        // Inverse diagonal
+        Vector diag(im, bs);
+        A.diagonal(diag);
+        const int n = diag.n_owned() * bs;
+        inv_diag_.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            const real_t d = diag.values()[i];
+            if (std::abs(d) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Zero diagonal entry at row {}, component {}\n", i / bs, i % bs));
+            }
+            inv_diag_[i] = 1.0 / d;
+        }
+
+        r_ = std::make_shared<Vector>(im, bs);
+        d_ = std::make_shared<Vector>(im, bs);
+
+        // Estimate the largest eigenvalue of D^-1 A by power iteration,
+        // starting from a vector that is unlikely to be orthogonal to the dominant eigenvector
+        Vector &v = *d_;
+        Vector &w = *r_;
+        for (int i = 0; i < n; i++)
+        {
+            v.values()[i] = 1.0 + 0.5 * std::sin(static_cast<real_t>(i));
+        }
+        scale(1.0 / norm(v, NormType::l2), v);
+
+        real_t lambda = 1.0;
+        for (int iter = 0; iter < options_.n_power_iter; iter++)
+        {
+            A.apply(v, w);
+            inv_diag_multiply(inv_diag_, 1.0, w, 0.0, w);
+            lambda = norm(w, NormType::l2);
+            if (lambda < std::numeric_limits<real_t>::min())
+            {
+                break;
+            }
+            copy(w, v);
+            scale(1.0 / lambda, v);
+        }
+        lambda_max_ = options_.safety * lambda;
+    }
+    //=============================================================================
+    void Chebyshev::apply(const Vector &x, Vector &y) const
+    {
+        if (A_ == nullptr)
+        {
+            SFEM_ERROR("Chebyshev preconditioner has not been set up\n");
+        }
+        SFEM_CHECK_SIZES(inv_diag_.size(), x.n_owned() * x.block_size());
+        SFEM_CHECK_SIZES(inv_diag_.size(), y.n_owned() * y.block_size());
+
+        Vector &r = *r_;
+        Vector &d = *d_;
+
+        // Chebyshev iteration on [lambda_max / ratio, lambda_max]
+        const real_t upper = lambda_max_;
+        const real_t lower = upper / options_.ratio;
+        const real_t theta = 0.5 * (upper + lower);
+        const real_t delta = 0.5 * (upper - lower);
+        const real_t sigma = theta / delta;
+        real_t rho = 1.0 / sigma;
+
+        inv_diag_multiply(inv_diag_, 1.0 / theta, x, 0.0, d);
+        copy(d, y);
+
+        for (int k = 1; k < options_.degree; k++)
+        {
+            const real_t rho_new = 1.0 / (2.0 * sigma - rho);
+            A_->apply(y, r);
+            axpbypc(1.0, -1.0, 0.0, x, r, r);
+            inv_diag_multiply(inv_diag_, 2.0 * rho_new / delta, r, rho_new * rho, d);
+            axpy(1.0, d, y);
+            rho = rho_new;
+        }
+    }
+    //=============================================================================
+    real_t Chebyshev::lambda_max() const
+    {
+        return lambda_max_;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <memory>
+#include <vector>
+
+namespace sfem::la
+{
+    /// @brief Options for the Chebyshev preconditioner
+    struct ChebyshevOptions
+    {
+        /// @brief Polynomial degree, i.e. number of Chebyshev iterations
+        int degree = 3;
+
+        /// @brief Ratio of the largest to the smallest eigenvalue of D^-1 A
+        /// targeted by the polynomial
+        real_t ratio = 30.0;
+
+        /// @brief Number of power iterations used to estimate
+        /// the largest eigenvalue of D^-1 A
+        int n_power_iter = 10;
+
+        /// @brief Factor by which the estimated largest eigenvalue is enlarged
+        real_t safety = 1.1;
+    };
+
+    /// @brief Chebyshev polynomial preconditioner, i.e. a fixed number of Chebyshev
+    /// iterations for D^-1 A, where D is the (point) diagonal of A, starting from a zero guess.
+    ///
+    /// Only the action and the diagonal of the operator are used, thus the preconditioner
+    /// is also applicable to matrix-free operators. The largest eigenvalue of D^-1 A is
+    /// estimated with a few power iterations
+    /// @note The operator is referenced, thus it must outlive the preconditioner's setup
+    class Chebyshev : public Preconditioner
+    {
+    public:
+        /// @brief Create a Chebyshev preconditioner
+        /// @param options Options
+        Chebyshev(ChebyshevOptions options = {});
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+        /// @brief Get the (enlarged) estimate of the largest eigenvalue of D^-1 A
+        real_t lambda_max() const;
+
+    protected:
+        void setup_matrix_free(const LinearOperator &A) override;
+
+    private:
+        /// @brief Set up the diagonal, eigenvalue estimate and work vectors for an operator
+        void setup_operator(const LinearOperator &A);
+
+        /// @brief Options
+        ChebyshevOptions options_;
+
+        /// @brief Operator storage (assembled matrices only)
+        std::shared_ptr<const LinearOperator> matrix_op_;
+
+        /// @brief Operator
+        const LinearOperator *A_;
+
+        /// @brief Inverse diagonal entries of the owned rows
+        std::vector<real_t> inv_diag_;
+
+        /// @brief Estimate of the largest eigenvalue of D^-1 A
+        real_t lambda_max_;
+
+        /// @brief Work vectors: residual, update
+        std::shared_ptr<Vector> r_;
+        std::shared_ptr<Vector> d_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "ilu.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/base/error.hpp>
+#include <cmath>
+#include <format>
+#include <limits>
+
+namespace sfem::la
+{
+    //=============================================================================
+    ILU0::ILU0()
+        : Preconditioner("ILU0")
+    {
+    }
+    //=============================================================================
+    void ILU0::setup(const SparseMatrix &A)
+    {
+        lu_ = extract_local_matrix(A);
+
+        const int n = lu_.n_rows;
+        const int bs = lu_.bs;
+        const int bs2 = bs * bs;
+        auto &values = lu_.values;
+
+        inv_diag_.assign(n * bs2, 0.0);
+        std::vector<real_t> tmp(bs2);
+
+        // Position of each column in the current row, -1 if not present
+        std::vector<int> col_pos(n, -1);
+
+        // IKJ variant, restricted to the sparsity pattern of A
+        for (int i = 0; i < n; i++)
+        {
+            for (int p = lu_.offsets[i]; p < lu_.offsets[i + 1]; p++)
+            {
+                col_pos[lu_.cols[p]] = p;
+            }
+
+            for (int p = lu_.offsets[i]; p < lu_.diag[i]; p++)
+            {
+                // L_ik = A_ik * U_kk^-1
+                const int k = lu_.cols[p];
+                std::span<real_t> l_ik(values.data() + p * bs2, bs2);
+                utils::matmult(bs, bs, bs, l_ik,
+                               std::span<const real_t>(inv_diag_.data() + k * bs2, bs2),
+                               tmp);
+                std::copy(tmp.cbegin(), tmp.cend(), l_ik.begin());
+
+                // A_ij -= L_ik * U_kj, for j > k in the pattern of row i
+                for (int q = lu_.diag[k] + 1; q < lu_.offsets[k + 1]; q++)
+                {
+                    const int pos = col_pos[lu_.cols[q]];
+                    if (pos < 0)
+                    {
+                        continue;
+                    }
+
+                    utils::matmult(bs, bs, bs, l_ik,
+                                   std::span<const real_t>(values.data() + q * bs2, bs2),
+                                   tmp);
+                    for (int k1 = 0; k1 < bs2; k1++)
+                    {
+                        values[pos * bs2 + k1] -= tmp[k1];
+                    }
+                }
+            }
+
+            std::span<const real_t> u_ii(values.data() + lu_.diag[i] * bs2, bs2);
+            std::span<real_t> inv_u_ii(inv_diag_.data() + i * bs2, bs2);
+            const real_t det = utils::inv(bs, u_ii, inv_u_ii);
+            if (std::abs(det) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Zero pivot block at row {}\n", i));
+            }
+
+            for (int p = lu_.offsets[i]; p < lu_.offsets[i + 1]; p++)
+            {
+                col_pos[lu_.cols[p]] = -1;
+            }
+        }
+
+        lower_levels_ = compute_levels(lu_, true);
+        upper_levels_ = compute_levels(lu_, false);
+    }
+    //=============================================================================
+    void ILU0::apply(const Vector &x, Vector &y) const
+    {
+        SFEM_CHECK_SIZES(lu_.bs, x.block_size());
+        SFEM_CHECK_SIZES(lu_.bs, y.block_size());
+        SFEM_CHECK_SIZES(lu_.n_rows, x.n_owned());
+        SFEM_CHECK_SIZES(lu_.n_rows, y.n_owned());
+
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        // Forward solve with the unit lower factor, then backward solve (in place)
+        triangular_solve(lu_, lower_levels_, true, nullptr, 1.0, xv, yv);
+        triangular_solve(lu_, upper_levels_, false, inv_diag_.data(), 1.0, yv, yv);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/preconditioners/local_matrix.hpp>
+
+namespace sfem::la
+{
+    /// @brief Incomplete (block) LU factorization with zero fill-in, ILU(0),
+    /// of the rank-local part of the matrix (block-Jacobi across processes).
+    /// The triangular solves are level-scheduled
+    class ILU0 : public Preconditioner
+    {
+    public:
+        ILU0();
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+    private:
+        /// @brief Factors L (strictly lower, unit diagonal) and U (strictly upper)
+        LocalMatrix lu_;
+
+        /// @brief Inverse diagonal blocks of U (row-major)
+        std::vector<real_t> inv_diag_;
+
+        /// @brief Level schedules of the forward and backward solves
+        graph::Connectivity lower_levels_;
+        graph::Connectivity upper_levels_;
+    };
+}
\ No newline at end of file
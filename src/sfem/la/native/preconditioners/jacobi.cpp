@@ -0,0 +1,145 @@
+#include "jacobi.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <cmath>
+#include <limits>
+
+namespace sfem::la
+{
+    //=============================================================================
+    Jacobi::Jacobi()
+        : Preconditioner("Jacobi")
+    {
+    }
+    //=============================================================================
+    void Jacobi::setup(const SparseMatrix &A)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int bs = A.block_size();
+        const auto diag_idxs = A.diagonal_idxs();
+        const auto &values = A.values();
+
+        inv_diag_.resize(n_owned * bs);
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (diag_idxs[i] < 0)
+            {
+                SFEM_ERROR(std::format("Row {} has no diagonal entry\n", i));
+            }
+
+            for (int k = 0; k < bs; k++)
+            {
+                const real_t d = values[diag_idxs[i] * bs * bs + k * bs + k];
+                if (std::abs(d) < std::numeric_limits<real_t>::min())
+                {
+                    SFEM_ERROR(std::format("Zero diagonal entry at row {}, component {}\n", i, k));
+                }
+                inv_diag_[i * bs + k] = 1.0 / d;
+            }
+        }
+    }
+    //=============================================================================
+    void Jacobi::setup_matrix_free(const LinearOperator &A)
+    {
+        const int bs = A.block_size();
+        Vector diag(A.index_map(), bs);
+        A.diagonal(diag);
+
+        const int n = diag.n_owned() * bs;
+        const auto &values = diag.values();
+        inv_diag_.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            if (std::abs(values[i]) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Zero diagonal entry at row {}, component {}\n", i / bs, i % bs));
+            }
+            inv_diag_[i] = 1.0 / values[i];
+        }
+    }
+    //=============================================================================
+    void Jacobi::apply(const Vector &x, Vector &y) const
+    {
+        SFEM_CHECK_SIZES(inv_diag_.size(), x.n_owned() * x.block_size());
+        SFEM_CHECK_SIZES(inv_diag_.size(), y.n_owned() * y.block_size());
+
+        const int n = static_cast<int>(inv_diag_.size());
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n; i++)
+        {
+            yv[i] = inv_diag_[i] * xv[i];
+        }
+    }
+    //=============================================================================
+    BlockJacobi::BlockJacobi()
+        : Preconditioner("BlockJacobi"),
+          bs_(1)
+    {
+    }
+    //=============================================================================
+    void BlockJacobi::setup(const SparseMatrix &A)
+    {
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const auto diag_idxs = A.diagonal_idxs();
+        const auto &values = A.values();
+        bs_ = A.block_size();
+
+        inv_blocks_.assign(n_owned * bs_ * bs_, 0.0);
+        for (int i = 0; i < n_owned; i++)
+        {
+            if (diag_idxs[i] < 0)
+            {
+                SFEM_ERROR(std::format("Row {} has no diagonal entry\n", i));
+            }
+
+            std::span<const real_t> block(values.data() + diag_idxs[i] * bs_ * bs_, bs_ * bs_);
+            std::span<real_t> inv_block(inv_blocks_.data() + i * bs_ * bs_, bs_ * bs_);
+            const real_t det = utils::inv(bs_, block, inv_block);
+            if (std::abs(det) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Singular diagonal block at row {}\n", i));
+            }
+        }
+    }
+    //=============================================================================
+    void BlockJacobi::apply(const Vector &x, Vector &y) const
+    {
+        SFEM_CHECK_SIZES(bs_, x.block_size());
+        SFEM_CHECK_SIZES(bs_, y.block_size());
+        SFEM_CHECK_SIZES(inv_blocks_.size(), x.n_owned() * bs_ * bs_);
+        SFEM_CHECK_SIZES(x.n_owned(), y.n_owned());
+
+        const int n = x.n_owned();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+        const real_t *inv = inv_blocks_.data();
+
+        dispatch_block_size(bs_, [&]<int BS>(std::integral_constant<int, BS>)
+                            {
+                                const int bs = BS > 0 ? BS : bs_;
+                                SFEM_OMP(parallel for)
+                                for (int i = 0; i < n; i++)
+                                {
+                                    const real_t *ib = inv + i * bs * bs;
+                                    const real_t *xb = xv + i * bs;
+                                    real_t *yb = yv + i * bs;
+                                    for (int k1 = 0; k1 < bs; k1++)
+                                    {
+                                        real_t sum = 0.0;
+                                        for (int k2 = 0; k2 < bs; k2++)
+                                        {
+                                            sum += ib[k1 * bs + k2] * xb[k2];
+                                        }
+                                        yb[k1] = sum;
+                                    }
+                                } });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/base/config.hpp>
+#include <vector>
+
+namespace sfem::la
+{
+    /// @brief Point-Jacobi preconditioner, i.e. M = diag(A)
+    class Jacobi : public Preconditioner
+    {
+    public:
+        Jacobi();
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+    protected:
+        /// @brief Set up using the diagonal computed by the operator
+        void setup_matrix_free(const LinearOperator &A) override;
+
+    private:
+        /// @brief Inverse diagonal entries of the owned rows
+        std::vector<real_t> inv_diag_;
+    };
+
+    /// @brief Block-Jacobi preconditioner, i.e. M = blockdiag(A),
+    /// where the blocks are the (bs x bs) diagonal blocks of the matrix
+    class BlockJacobi : public Preconditioner
+    {
+    public:
+        BlockJacobi();
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+    private:
+        /// @brief Block size
+        int bs_;
+
+        /// @brief Inverse diagonal blocks of the owned rows (row-major)
+        std::vector<real_t> inv_blocks_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "local_matrix.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numeric>
+
+namespace sfem::la
+{
+    //=============================================================================
+    template <int BS>
+    static void solve_row(const LocalMatrix &M,
+                          int row,
+                          bool lower,
+                          const real_t *inv_diag,
+                          real_t omega,
+                          const real_t *rhs,
+                          real_t *sol,
+                          real_t *acc)
+    {
+        const int bs = BS > 0 ? BS : M.bs;
+        const int begin = lower ? M.offsets[row] : M.diag[row] + 1;
+        const int end = lower ? M.diag[row] : M.offsets[row + 1];
+
+        std::fill(acc, acc + bs, 0.0);
+        for (int p = begin; p < end; p++)
+        {
+            const real_t *mp = M.values.data() + p * bs * bs;
+            const real_t *sj = sol + M.cols[p] * bs;
+            for (int k1 = 0; k1 < bs; k1++)
+            {
+                for (int k2 = 0; k2 < bs; k2++)
+                {
+                    acc[k1] += mp[k1 * bs + k2] * sj[k2];
+                }
+            }
+        }
+
+        const real_t *ri = rhs + row * bs;
+        for (int k = 0; k < bs; k++)
+        {
+            acc[k] = ri[k] - omega * acc[k];
+        }
+
+        real_t *si = sol + row * bs;
+        if (inv_diag)
+        {
+            const real_t *di = inv_diag + row * bs * bs;
+            for (int k1 = 0; k1 < bs; k1++)
+            {
+                real_t sum = 0.0;
+                for (int k2 = 0; k2 < bs; k2++)
+                {
+                    sum += di[k1 * bs + k2] * acc[k2];
+                }
+                si[k1] = sum;
+            }
+        }
+        else
+        {
+            std::copy(acc, acc + bs, si);
+        }
+    }
+    //=============================================================================
+    LocalMatrix extract_local_matrix(const SparseMatrix &A)
+    {
+        const auto row_to_col = A.connectivity();
+        const int n_owned = A.index_maps()[0]->n_owned();
+        const int n_owned_cols = A.index_maps()[1]->n_owned();
+        const int bs = A.block_size();
+        const int bs2 = bs * bs;
+
+        LocalMatrix local;
+        local.n_rows = n_owned;
+        local.bs = bs;
+        local.offsets.resize(n_owned + 1, 0);
+        local.diag.resize(n_owned, -1);
+
+        // Count the owned columns of each row
+        for (int i = 0; i < n_owned; i++)
+        {
+            auto cols = row_to_col->links(i);
+            local.offsets[i + 1] = local.offsets[i] +
+                                   static_cast<int>(std::count_if(cols.begin(), cols.end(),
+                                                                  [n_owned_cols](int c)
+                                                                  { return c < n_owned_cols; }));
+        }
+
+        // Copy the owned columns and their values, sorting them per row
+        local.cols.resize(local.offsets.back());
+        local.values.resize(local.offsets.back() * bs2);
+        std::vector<int> perm;
+        for (int i = 0; i < n_owned; i++)
+        {
+            auto [cols, values] = A.row_data(i);
+            perm.resize(cols.size());
+            std::iota(perm.begin(), perm.end(), 0);
+            std::sort(perm.begin(), perm.end(), [&cols](int a, int b)
+                      { return cols[a] < cols[b]; });
+
+            int pos = local.offsets[i];
+            for (int p : perm)
+            {
+                if (cols[p] >= n_owned_cols)
+                {
+                    continue;
+                }
+
+                if (cols[p] == i)
+                {
+                    local.diag[i] = pos;
+                }
+                local.cols[pos] = cols[p];
+                std::copy(values.begin() + p * bs2,
+                          values.begin() + (p + 1) * bs2,
+                          local.values.begin() + pos * bs2);
+                pos++;
+            }
+
+            if (local.diag[i] < 0)
+            {
+                SFEM_ERROR(std::format("Row {} has no diagonal entry\n", i));
+            }
+        }
+
+        return local;
+    }
+    //=============================================================================
+    graph::Connectivity compute_levels(const LocalMatrix &A, bool lower)
+    {
+        const int n = A.n_rows;
+
+        // The level of a row is one more than the maximum level of the rows it depends on
+        std::vector<int> levels(n, 0);
+        int n_levels = n > 0 ? 1 : 0;
+        for (int ii = 0; ii < n; ii++)
+        {
+            const int i = lower ? ii : n - 1 - ii;
+            const int begin = lower ? A.offsets[i] : A.diag[i] + 1;
+            const int end = lower ? A.diag[i] : A.offsets[i + 1];
+            for (int p = begin; p < end; p++)
+            {
+                levels[i] = std::max(levels[i], levels[A.cols[p]] + 1);
+            }
+            n_levels = std::max(n_levels, levels[i] + 1);
+        }
+
+        // Group the rows by level
+        std::vector<int> offsets(n_levels + 1, 0);
+        for (int level : levels)
+        {
+            offsets[level + 1]++;
+        }
+        std::inclusive_scan(offsets.cbegin(), offsets.cend(), offsets.begin());
+
+        std::vector<int> array(n);
+        std::vector<int> n_rows(n_levels, 0);
+        for (int i = 0; i < n; i++)
+        {
+            array[offsets[levels[i]] + n_rows[levels[i]]++] = i;
+        }
+
+        return graph::Connectivity(std::move(offsets), std::move(array));
+    }
+    //=============================================================================
+    std::vector<real_t> invert_diagonal_blocks(const LocalMatrix &A)
+    {
+        const int bs2 = A.bs * A.bs;
+        std::vector<real_t> inv_diag(A.n_rows * bs2, 0.0);
+        for (int i = 0; i < A.n_rows; i++)
+        {
+            std::span<const real_t> block(A.values.data() + A.diag[i] * bs2, bs2);
+            std::span<real_t> inv_block(inv_diag.data() + i * bs2, bs2);
+            const real_t det = utils::inv(A.bs, block, inv_block);
+            if (std::abs(det) < std::numeric_limits<real_t>::min())
+            {
+                SFEM_ERROR(std::format("Singular diagonal block at row {}\n", i));
+            }
+        }
+        return inv_diag;
+    }
+    //=============================================================================
+    void triangular_solve(const LocalMatrix &M,
+                          const graph::Connectivity &levels,
+                          bool lower,
+                          const real_t *inv_diag,
+                          real_t omega,
+                          const real_t *rhs,
+                          real_t *sol)
+    {
+        dispatch_block_size(M.bs, [&]<int BS>(std::integral_constant<int, BS>)
+                            {
+                                SFEM_OMP(parallel)
+                                {
+                                    std::vector<real_t> acc(M.bs);
+                                    for (int l = 0; l < levels.n_primary(); l++)
+                                    {
+                                        const auto rows = levels.links(l);
+                                        const int n_rows = static_cast<int>(rows.size());
+                                        SFEM_OMP(for)
+                                        for (int ii = 0; ii < n_rows; ii++)
+                                        {
+                                            solve_row<BS>(M, rows[ii], lower, inv_diag,
+                                                          omega, rhs, sol, acc.data());
+                                        }
+                                    }
+                                } });
+    }
+    //=============================================================================
+    void diagonal_multiply(const LocalMatrix &M, const real_t *x, real_t *y)
+    {
+        const int bs = M.bs;
+        SFEM_OMP(parallel)
+        {
+            std::vector<real_t> acc(bs);
+            SFEM_OMP(for)
+            for (int i = 0; i < M.n_rows; i++)
+            {
+                const real_t *di = M.values.data() + M.diag[i] * bs * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    acc[k1] = 0.0;
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        acc[k1] += di[k1 * bs + k2] * x[i * bs + k2];
+                    }
+                }
+                std::copy(acc.cbegin(), acc.cend(), y + i * bs);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <sfem/graph/connectivity.hpp>
+#include <sfem/base/config.hpp>
+#include <vector>
+
+namespace sfem::la
+{
+    // Forward declaration
+    class SparseMatrix;
+
+    /// @brief The rank-local part of a SparseMatrix, i.e. the coupling between
+    /// owned rows and owned columns, stored in block CSR format with sorted columns.
+    /// Preconditioners built on it act as block-Jacobi across processes,
+    /// since couplings with ghost columns are ignored
+    struct LocalMatrix
+    {
+        /// @brief Number of (block) rows
+        int n_rows = 0;
+
+        /// @brief Block size
+        int bs = 1;
+
+        /// @brief Row offsets
+        std::vector<int> offsets;
+
+        /// @brief Column indices (sorted per row)
+        std::vector<int> cols;
+
+        /// @brief Position of the diagonal block of each row
+        std::vector<int> diag;
+
+        /// @brief Block values (row-major blocks)
+        std::vector<real_t> values;
+    };
+
+    /// @brief Extract the rank-local part of a matrix
+    /// @note Raises an error if an owned row has no diagonal block
+    LocalMatrix extract_local_matrix(const SparseMatrix &A);
+
+    /// @brief Compute the level schedule of a triangular solve,
+    /// i.e. partition the rows into levels such that each row only depends
+    /// on rows of previous levels
+    /// @param A Local matrix
+    /// @param lower Whether the schedule is for the (strictly) lower
+    /// or upper triangular part of the matrix
+    /// @return Level-to-row connectivity
+    graph::Connectivity compute_levels(const LocalMatrix &A, bool lower);
+
+    /// @brief Invert the diagonal blocks of a local matrix
+    /// @return Inverse diagonal blocks (row-major)
+    std::vector<real_t> invert_diagonal_blocks(const LocalMatrix &A);
+
+    /// @brief Level-scheduled (block) triangular solve, i.e. for each row:
+    /// sol_i = D_i * (rhs_i - omega * sum_j M_ij * sol_j),
+    /// where j runs over the strictly lower or upper triangular part of row i.
+    /// Rows within a level are processed in parallel
+    /// @param M Local matrix
+    /// @param levels Level schedule, as computed by compute_levels
+    /// @param lower Whether to use the lower or upper triangular part
+    /// @param inv_diag Blocks D_i (row-major), or nullptr for the identity
+    /// @param omega Scaling of the off-diagonal part
+    /// @param rhs Right-hand side (may alias sol)
+    /// @param sol Solution
+    void triangular_solve(const LocalMatrix &M,
+                          const graph::Connectivity &levels,
+                          bool lower,
+                          const real_t *inv_diag,
+                          real_t omega,
+                          const real_t *rhs,
+                          real_t *sol);
+
+    /// @brief Multiply by the block diagonal of a local matrix: y_i = M_ii * x_i
+    /// @note x may alias y
+    void diagonal_multiply(const LocalMatrix &M, const real_t *x, real_t *y);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "preconditioner.hpp"
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/base/error.hpp>
+
+namespace sfem::la
+{
+    //=============================================================================
+    Preconditioner::Preconditioner(const std::string &name)
+        : name_(name)
+    {
+    }
+    //=============================================================================
+    std::string Preconditioner::name() const
+    {
+        return name_;
+    }
+    //=============================================================================
+    void Preconditioner::setup(const LinearOperator &A)
+    {
+        if (const SparseMatrix *mat = A.matrix())
+        {
+            setup(*mat);
+        }
+        else
+        {
+            setup_matrix_free(A);
+        }
+    }
+    //=============================================================================
+    void Preconditioner::setup_matrix_free(const LinearOperator &)
+    {
+        SFEM_ERROR(std::format("Preconditioner {} requires an assembled matrix\n", name_));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+namespace sfem::la
+{
+    // Forward declarations
+    class Vector;
+    class SparseMatrix;
+    class LinearOperator;
+
+    /// @brief Preconditioner ABC.
+    /// A preconditioner approximates the action of the inverse of a matrix,
+    /// i.e. y = M^-1 x, where M is an approximation of A
+    class Preconditioner
+    {
+    public:
+        /// @brief Create a preconditioner
+        Preconditioner(const std::string &name);
+
+        // Destructor
+        virtual ~Preconditioner() = default;
+
+        /// @brief Get the preconditioner's name
+        std::string name() const;
+
+        /// @brief Set up the preconditioner for a given matrix
+        /// @note Should be called whenever the matrix values change
+        virtual void setup(const SparseMatrix &A) = 0;
+
+        /// @brief Set up the preconditioner for a given linear operator.
+        /// Operators with an assembled matrix are forwarded to setup(const SparseMatrix &),
+        /// while matrix-free operators are handled by setup_matrix_free()
+        void setup(const LinearOperator &A);
+
+        /// @brief Apply the preconditioner, i.e. compute y = M^-1 x
+        /// @note Only the values of owned indices are computed
+        virtual void apply(const Vector &x, Vector &y) const = 0;
+
+    protected:
+        /// @brief Set up the preconditioner for a matrix-free operator
+        /// @note The default implementation raises an error, since most preconditioners
+        /// require access to the matrix entries
+        virtual void setup_matrix_free(const LinearOperator &A);
+
+        /// @brief Preconditioner name
+        std::string name_;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "preconditioner_factory.hpp"
+#include <sfem/la/native/preconditioners/jacobi.hpp>
+#include <sfem/la/native/preconditioners/ilu.hpp>
+#include <sfem/la/native/preconditioners/ssor.hpp>
+#include <sfem/la/native/preconditioners/block_gauss_seidel.hpp>
+#include <sfem/la/native/preconditioners/amg.hpp>
+#include <sfem/la/native/preconditioners/chebyshev.hpp>
+
+namespace sfem::la
+{
+    Preconditioner *create_preconditioner(PreconditionerType type)
+    {
+        Preconditioner *pc = nullptr;
+        switch (type)
+        {
+        case PreconditionerType::jacobi:
+            pc = new Jacobi();
+            break;
+        case PreconditionerType::block_jacobi:
+            pc = new BlockJacobi();
+            break;
+        case PreconditionerType::ilu0:
+            pc = new ILU0();
+            break;
+        case PreconditionerType::ssor:
+            pc = new SSOR();
+            break;
+        case PreconditionerType::block_gauss_seidel:
+            pc = new BlockGaussSeidel();
+            break;
+        case PreconditionerType::block_gauss_seidel_sp:
+            pc = new BlockGaussSeidel(1, true);
+            break;
+        case PreconditionerType::amg:
+            pc = new AMG();
+            break;
+        case PreconditionerType::chebyshev:
+            pc = new Chebyshev();
+            break;
+        default:
+            break;
+        }
+        return pc;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "preconditioner.hpp"
+
+namespace sfem::la
+{
+    enum class PreconditionerType
+    {
+        none,
+        jacobi,
+        block_jacobi,
+        ilu0,
+        ssor,
+        block_gauss_seidel,
+        block_gauss_seidel_sp,
+        amg,
+        chebyshev
+    };
+
+    /// @brief Create a preconditioner of a given type
+    /// @note Returns nullptr for PreconditionerType::none
+    Preconditioner *create_preconditioner(PreconditionerType type);
+}
\ No newline at end of file
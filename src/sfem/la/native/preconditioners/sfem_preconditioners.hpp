@@ -0,0 +1,11 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/preconditioners/jacobi.hpp>
+#include <sfem/la/native/preconditioners/local_matrix.hpp>
+#include <sfem/la/native/preconditioners/ilu.hpp>
+#include <sfem/la/native/preconditioners/ssor.hpp>
+#include <sfem/la/native/preconditioners/block_gauss_seidel.hpp>
+#include <sfem/la/native/preconditioners/amg.hpp>
+#include <sfem/la/native/preconditioners/chebyshev.hpp>
+#include <sfem/la/native/preconditioners/preconditioner_factory.hpp>
\ No newline at end of file
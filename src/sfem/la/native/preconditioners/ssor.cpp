@@ -0,0 +1,54 @@
+#include "ssor.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <format>
+
+namespace sfem::la
+{
+    //=============================================================================
+    SSOR::SSOR(real_t omega)
+        : Preconditioner("SSOR"),
+          omega_(omega)
+    {
+        if (omega_ <= 0.0 or omega_ >= 2.0)
+        {
+            SFEM_ERROR(std::format("Invalid SSOR relaxation factor: {}\n", omega_));
+        }
+    }
+    //=============================================================================
+    void SSOR::setup(const SparseMatrix &A)
+    {
+        local_ = extract_local_matrix(A);
+        inv_diag_ = invert_diagonal_blocks(local_);
+        lower_levels_ = compute_levels(local_, true);
+        upper_levels_ = compute_levels(local_, false);
+    }
+    //=============================================================================
+    void SSOR::apply(const Vector &x, Vector &y) const
+    {
+        SFEM_CHECK_SIZES(local_.bs, x.block_size());
+        SFEM_CHECK_SIZES(local_.bs, y.block_size());
+        SFEM_CHECK_SIZES(local_.n_rows, x.n_owned());
+        SFEM_CHECK_SIZES(local_.n_rows, y.n_owned());
+
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        // Forward sweep: y = (D + wL)^-1 x
+        triangular_solve(local_, lower_levels_, true, inv_diag_.data(), omega_, xv, yv);
+
+        // Backward sweep: y = (D + wU)^-1 D y
+        diagonal_multiply(local_, yv, yv);
+        triangular_solve(local_, upper_levels_, false, inv_diag_.data(), omega_, yv, yv);
+
+        const int n = local_.n_rows * local_.bs;
+        const real_t scale = omega_ * (2.0 - omega_);
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n; i++)
+        {
+            yv[i] *= scale;
+        }
+    }
+}
\ No newline at end of file
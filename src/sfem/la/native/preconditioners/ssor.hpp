@@ -0,0 +1,40 @@
+#pragma once
+
+#include <sfem/la/native/preconditioners/preconditioner.hpp>
+#include <sfem/la/native/preconditioners/local_matrix.hpp>
+
+namespace sfem::la
+{
+    /// @brief (Block) symmetric successive over-relaxation preconditioner,
+    /// i.e. M = (D + wL) D^-1 (D + wU) / (w(2 - w)), applied to the rank-local
+    /// part of the matrix (block-Jacobi across processes).
+    /// For w = 1 this is a symmetric Gauss-Seidel sweep.
+    /// The triangular solves are level-scheduled
+    class SSOR : public Preconditioner
+    {
+    public:
+        /// @brief Create an SSOR preconditioner
+        /// @param omega Relaxation factor, in (0, 2)
+        SSOR(real_t omega = 1.0);
+
+        using Preconditioner::setup;
+
+        void setup(const SparseMatrix &A) override;
+
+        void apply(const Vector &x, Vector &y) const override;
+
+    private:
+        /// @brief Relaxation factor
+        real_t omega_;
+
+        /// @brief Rank-local part of the matrix
+        LocalMatrix local_;
+
+        /// @brief Inverse diagonal blocks (row-major)
+        std::vector<real_t> inv_diag_;
+
+        /// @brief Level schedules of the forward and backward sweeps
+        graph::Connectivity lower_levels_;
+        graph::Connectivity upper_levels_;
+    };
+}
\ No newline at end of file
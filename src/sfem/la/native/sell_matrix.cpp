@@ -0,0 +1,254 @@
+#include "sell_matrix.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/parallel/mpi.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Get the partition of a set of slices among the threads,
+    /// recomputed if the number of threads has changed
+    static const std::vector<int> &thread_blocks(const SellMatrix::Slices &S)
+    {
+        const int n_blocks = omp::n_threads();
+        if (static_cast<int>(S.thread_blocks.size()) != n_blocks + 1)
+        {
+            S.thread_blocks = omp::balanced_partition(S.offsets, n_blocks);
+        }
+        return S.thread_blocks;
+    }
+    //=============================================================================
+    /// @brief Compute y = Ax for the rows of a set of slices, split among the threads
+    static void spmv_slices(const SellMatrix::Slices &S, const real_t *x, real_t *y)
+    {
+        constexpr int C = SellMatrix::chunk_size;
+        const auto &bounds = thread_blocks(S);
+        const int n_chunks = static_cast<int>(bounds.size()) - 1;
+
+        SFEM_OMP(parallel for schedule(static, 1))
+        for (int t = 0; t < n_chunks; t++)
+        {
+            for (int s = bounds[t]; s < bounds[t + 1]; s++)
+            {
+                const int offset = S.offsets[s];
+                const int width = (S.offsets[s + 1] - offset) / C;
+                std::array<real_t, C> acc{};
+                for (int j = 0; j < width; j++)
+                {
+                    const int *cols = S.cols.data() + offset + j * C;
+                    const real_t *values = S.values.data() + offset + j * C;
+                    SFEM_OMP(simd)
+                    for (int r = 0; r < C; r++)
+                    {
+                        acc[r] += values[r] * x[cols[r]];
+                    }
+                }
+
+                const int *rows = S.rows.data() + s * C;
+                for (int r = 0; r < C; r++)
+                {
+                    if (rows[r] >= 0)
+                    {
+                        y[rows[r]] = acc[r];
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    SellMatrix::SellMatrix(const SparseMatrix &A, int sigma)
+        : A_(A),
+          sigma_(sigma)
+    {
+        if (A_.block_size() != 1)
+        {
+            SFEM_ERROR(std::format("SellMatrix requires block size 1 (got {})\n", A_.block_size()));
+        }
+        if (A_.index_maps()[0] != A_.index_maps()[1])
+        {
+            SFEM_ERROR("SellMatrix requires a square matrix with the same row and column index map\n");
+        }
+        if (sigma_ < 1)
+        {
+            SFEM_ERROR(std::format("Invalid SELL sorting window: {}\n", sigma_));
+        }
+
+        interior_ = create_slices(A_.interior_rows());
+        boundary_ = create_slices(A_.boundary_rows());
+        update_values();
+    }
+    //=============================================================================
+    SellMatrix::Slices SellMatrix::create_slices(std::span<const int> rows) const
+    {
+        constexpr int C = chunk_size;
+        const auto &row_to_col = *A_.connectivity();
+        const int n_rows = static_cast<int>(rows.size());
+        const int n_slices = (n_rows + C - 1) / C;
+
+        // Sort the rows by decreasing length within each window
+        Slices S;
+        S.rows.assign(n_slices * C, -1);
+        std::copy(rows.begin(), rows.end(), S.rows.begin());
+        for (int w = 0; w < n_rows; w += sigma_)
+        {
+            std::stable_sort(S.rows.begin() + w,
+                             S.rows.begin() + std::min(w + sigma_, n_rows),
+                             [&row_to_col](int a, int b)
+                             { return row_to_col.n_links(a) > row_to_col.n_links(b); });
+        }
+
+        // Slice widths, i.e. the longest row of each slice
+        S.offsets.assign(n_slices + 1, 0);
+        for (int s = 0; s < n_slices; s++)
+        {
+            int width = 0;
+            for (int r = 0; r < C; r++)
+            {
+                if (const int row = S.rows[s * C + r]; row >= 0)
+                {
+                    width = std::max(width, row_to_col.n_links(row));
+                }
+            }
+            S.offsets[s + 1] = S.offsets[s] + width * C;
+        }
+
+        // Column indices and positions of the entries, column-major within each slice.
+        // Padding entries refer to the row's own (or, for padding rows, the first) column,
+        // so that the multiplication reads valid entries of x
+        S.cols.resize(S.offsets.back());
+        S.csr_idxs.resize(S.offsets.back());
+        for (int s = 0; s < n_slices; s++)
+        {
+            const int width = (S.offsets[s + 1] - S.offsets[s]) / C;
+            for (int r = 0; r < C; r++)
+            {
+                const int row = S.rows[s * C + r];
+                const auto cols = row >= 0 ? row_to_col.links(row) : std::span<const int>{};
+                for (int j = 0; j < width; j++)
+                {
+                    const int pos = S.offsets[s] + j * C + r;
+                    if (j < static_cast<int>(cols.size()))
+                    {
+                        S.cols[pos] = cols[j];
+                        S.csr_idxs[pos] = row_to_col.offset(row) + j;
+                    }
+                    else
+                    {
+                        S.cols[pos] = row >= 0 ? row : 0;
+                        S.csr_idxs[pos] = -1;
+                    }
+                }
+            }
+        }
+
+        S.values.resize(S.offsets.back());
+        return S;
+    }
+    //=============================================================================
+    void SellMatrix::update_values()
+    {
+        const auto &a = A_.values();
+        for (Slices *S : {&interior_, &boundary_})
+        {
+            const int n = static_cast<int>(S->values.size());
+            SFEM_OMP(parallel for)
+            for (int i = 0; i < n; i++)
+            {
+                const int idx = S->csr_idxs[i];
+                S->values[i] = idx >= 0 ? a[idx] : 0.0;
+            }
+        }
+    }
+    //=============================================================================
+    int SellMatrix::sigma() const
+    {
+        return sigma_;
+    }
+    //=============================================================================
+    const SellMatrix::Slices &SellMatrix::interior_slices() const
+    {
+        return interior_;
+    }
+    //=============================================================================
+    const SellMatrix::Slices &SellMatrix::boundary_slices() const
+    {
+        return boundary_;
+    }
+    //=============================================================================
+    real_t SellMatrix::fill_ratio() const
+    {
+        const auto &row_to_col = *A_.connectivity();
+        const int n_owned = index_map()->n_owned();
+        const auto n_stored = static_cast<real_t>(interior_.values.size() + boundary_.values.size());
+        const auto n_nonzero = static_cast<real_t>(row_to_col.offset(n_owned));
+        return mpi::reduce(n_stored, mpi::ReduceOperation::sum) /
+               mpi::reduce(n_nonzero, mpi::ReduceOperation::sum);
+    }
+    //=============================================================================
+    std::shared_ptr<const IndexMap> SellMatrix::index_map() const
+    {
+        return A_.index_maps()[0];
+    }
+    //=============================================================================
+    int SellMatrix::block_size() const
+    {
+        return 1;
+    }
+    //=============================================================================
+    void SellMatrix::apply(Vector &x, Vector &y) const
+    {
+        spmv_overlap(*this, x, y);
+    }
+    //=============================================================================
+    void SellMatrix::diagonal(Vector &diag) const
+    {
+        A_.diagonal(diag);
+    }
+    //=============================================================================
+    const SparseMatrix *SellMatrix::matrix() const
+    {
+        return &A_;
+    }
+    //=============================================================================
+    void spmv(const SellMatrix &A,
+              const Vector &x,
+              Vector &y)
+    {
+        const auto im = A.index_map();
+        SFEM_CHECK_SIZES(im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(1, x.block_size());
+        SFEM_CHECK_SIZES(1, y.block_size());
+
+        spmv_slices(A.interior_slices(), x.values().data(), y.values().data());
+        spmv_slices(A.boundary_slices(), x.values().data(), y.values().data());
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + im->n_owned(), y.values().end(), 0.0);
+    }
+    //=============================================================================
+    void spmv_overlap(const SellMatrix &A,
+                      Vector &x,
+                      Vector &y)
+    {
+        const auto im = A.index_map();
+        SFEM_CHECK_SIZES(im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(1, x.block_size());
+        SFEM_CHECK_SIZES(1, y.block_size());
+
+        // The interior rows only require the owned values of x,
+        // so they are computed while the ghost values are exchanged
+        x.update_ghosts_begin();
+        spmv_slices(A.interior_slices(), x.values().data(), y.values().data());
+        x.update_ghosts_end();
+        spmv_slices(A.boundary_slices(), x.values().data(), y.values().data());
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + im->n_owned(), y.values().end(), 0.0);
+    }
+}
\ No newline at end of file
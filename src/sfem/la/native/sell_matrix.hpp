@@ -0,0 +1,108 @@
+#pragma once
+
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/base/config.hpp>
+#include <span>
+#include <vector>
+
+namespace sfem::la
+{
+    /// @brief MPI-parallel sparse matrix in SELL-C-sigma (sliced ELLPACK) format, for block size 1.
+    ///
+    /// Rows are sorted by decreasing length within windows of sigma rows, and then grouped
+    /// into slices of C consecutive rows. Each slice is stored column-major and padded to its
+    /// longest row, so that the multiplication processes the C rows of a slice with vector
+    /// operations. Sorting limits the padding, while the window keeps the rows close to their
+    /// original position. The interior and boundary rows (see SparseMatrix::interior_rows)
+    /// are sliced separately, so that the ghost value update of x can be overlapped with
+    /// the multiplication.
+    ///
+    /// A SellMatrix is a copy of an assembled SparseMatrix, with the same sparsity and index maps.
+    /// The SparseMatrix remains the target of assembly, and is returned by matrix(), so that
+    /// preconditioners requiring the matrix entries can be set up from the SellMatrix
+    /// @note The matrix is referenced, thus it must outlive the SellMatrix
+    class SellMatrix : public LinearOperator
+    {
+    public:
+        /// @brief Chunk height (C), i.e. number of rows per slice
+        static constexpr int chunk_size = 8;
+
+        /// @brief Rows stored in sliced ELLPACK format
+        struct Slices
+        {
+            /// @brief Row of each slot (chunk_size per slice), or -1 for padding
+            std::vector<int> rows;
+
+            /// @brief Offset of each slice in the column and value arrays
+            std::vector<int> offsets;
+
+            /// @brief Column indices (column-major within each slice)
+            std::vector<int> cols;
+
+            /// @brief Position of each entry in the values of the SparseMatrix,
+            /// or -1 for padding
+            std::vector<int> csr_idxs;
+
+            /// @brief Values (column-major within each slice)
+            std::vector<real_t> values;
+
+            /// @brief Partition of the slices among the threads (see omp::balanced_partition),
+            /// computed on first multiplication and whenever the number of threads changes
+            mutable std::vector<int> thread_blocks;
+        };
+
+        /// @brief Create a SellMatrix
+        /// @param A Sparse matrix (square, with block size 1)
+        /// @param sigma Sorting window, i.e. number of rows sorted by length
+        /// (1 for no sorting)
+        SellMatrix(const SparseMatrix &A, int sigma = 256);
+
+        /// @brief Copy the values of the sparse matrix, e.g. after re-assembly
+        void update_values();
+
+        /// @brief Get the sorting window
+        int sigma() const;
+
+        /// @brief Get the slices of the interior rows
+        const Slices &interior_slices() const;
+
+        /// @brief Get the slices of the boundary rows
+        const Slices &boundary_slices() const;
+
+        /// @brief Get the ratio of stored entries (including padding) to non-zero entries
+        real_t fill_ratio() const;
+
+        std::shared_ptr<const IndexMap> index_map() const override;
+
+        int block_size() const override;
+
+        void apply(Vector &x, Vector &y) const override;
+
+        void diagonal(Vector &diag) const override;
+
+        const SparseMatrix *matrix() const override;
+
+    private:
+        /// @brief Slice a list of rows
+        Slices create_slices(std::span<const int> rows) const;
+
+        /// @brief Sparse matrix
+        const SparseMatrix &A_;
+
+        /// @brief Sorting window
+        int sigma_;
+
+        /// @brief Slices of the interior and boundary rows
+        Slices interior_;
+        Slices boundary_;
+    };
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax
+    /// @note The ghost index values of x should be updated before calling
+    void spmv(const SellMatrix &A, const Vector &x, Vector &y);
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax, with the ghost value update of x
+    /// overlapped with the multiplication of the interior rows
+    /// @note Updates the ghost index values of x
+    void spmv_overlap(const SellMatrix &A, Vector &x, Vector &y);
+}
\ No newline at end of file
@@ -2,8 +2,15 @@
 
 #include <sfem/la/native/dense_matrix.hpp>
 #include <sfem/la/native/dense_matrix_utils.hpp>
+#include <sfem/la/native/static_matrix.hpp>
 #include <sfem/la/native/sparsity.hpp>
 #include <sfem/la/native/vector.hpp>
 #include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/bsr_matrix.hpp>
+#include <sfem/la/native/sell_matrix.hpp>
+#include <sfem/la/native/single_precision_matrix.hpp>
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
 #include <sfem/la/native/setval_utils.hpp>
+#include <sfem/la/native/preconditioners/sfem_preconditioners.hpp>
 #include <sfem/la/native/linear_solvers/sfem_linear_solvers.hpp>
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "single_precision_matrix.hpp"
+#include <sfem/la/native/sparse_matrix.hpp>
+#include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <sfem/base/error.hpp>
+
+namespace sfem::la
+{
+    //=============================================================================
+    /// @brief Compute y = Ax for the rows rows[row_begin], ..., rows[row_end - 1],
+    /// accumulating in working precision.
+    /// BS is the block size, or 0 if it is only known at runtime (bs_runtime)
+    template <int BS>
+    static void spmv_rows_sp(const graph::Connectivity &row_to_col,
+                             const float *a,
+                             const real_t *x,
+                             real_t *y,
+                             const int *rows,
+                             int row_begin,
+                             int row_end,
+                             int bs_runtime)
+    {
+        const int bs = BS > 0 ? BS : bs_runtime;
+        for (int k = row_begin; k < row_end; k++)
+        {
+            const int r = rows[k];
+            const auto cols = row_to_col.links(r);
+            const float *ar = a + row_to_col.offset(r) * bs * bs;
+            real_t *yr = y + r * bs;
+            std::fill(yr, yr + bs, 0.0);
+            for (std::size_t c = 0; c < cols.size(); c++)
+            {
+                const float *ac = ar + c * bs * bs;
+                const real_t *xc = x + cols[c] * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        yr[k1] += static_cast<real_t>(ac[k1 * bs + k2]) * xc[k2];
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    SinglePrecisionMatrix::SinglePrecisionMatrix(const SparseMatrix &A)
+        : A_(A)
+    {
+        if (A_.index_maps()[0] != A_.index_maps()[1])
+        {
+            SFEM_ERROR("SinglePrecisionMatrix requires a square matrix with the same row and column index map\n");
+        }
+        update_values();
+    }
+    //=============================================================================
+    void SinglePrecisionMatrix::update_values()
+    {
+        const auto &a = A_.values();
+        const int n = static_cast<int>(a.size());
+        values_.resize(a.size());
+        SFEM_OMP(parallel for)
+        for (int i = 0; i < n; i++)
+        {
+            values_[i] = static_cast<float>(a[i]);
+        }
+    }
+    //=============================================================================
+    std::shared_ptr<const graph::Connectivity> SinglePrecisionMatrix::connectivity() const
+    {
+        return A_.connectivity();
+    }
+    //=============================================================================
+    const std::vector<float> &SinglePrecisionMatrix::values() const
+    {
+        return values_;
+    }
+    //=============================================================================
+    std::shared_ptr<const IndexMap> SinglePrecisionMatrix::index_map() const
+    {
+        return A_.index_maps()[0];
+    }
+    //=============================================================================
+    int SinglePrecisionMatrix::block_size() const
+    {
+        return A_.block_size();
+    }
+    //=============================================================================
+    void SinglePrecisionMatrix::apply(Vector &x, Vector &y) const
+    {
+        spmv_overlap(*this, x, y);
+    }
+    //=============================================================================
+    void SinglePrecisionMatrix::diagonal(Vector &diag) const
+    {
+        A_.diagonal(diag);
+    }
+    //=============================================================================
+    const SparseMatrix *SinglePrecisionMatrix::matrix() const
+    {
+        return &A_;
+    }
+    //=============================================================================
+    void spmv_overlap(const SinglePrecisionMatrix &A,
+                      Vector &x,
+                      Vector &y)
+    {
+        const int bs = A.block_size();
+        const auto im = A.index_map();
+
+        SFEM_CHECK_SIZES(im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(bs, x.block_size());
+        SFEM_CHECK_SIZES(bs, y.block_size());
+
+        const auto row_to_col = A.connectivity();
+        const float *a = A.values().data();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+        const int n_threads = omp::n_threads();
+
+        // Compute y = Ax for a list of rows, split evenly among the threads
+        auto multiply_rows = [&](std::span<const int> rows)
+        {
+            const int n_rows = static_cast<int>(rows.size());
+            dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                                {
+                                    SFEM_OMP(parallel for schedule(static, 1))
+                                    for (int t = 0; t < n_threads; t++)
+                                    {
+                                        spmv_rows_sp<BS>(*row_to_col, a, xv, yv, rows.data(),
+                                                         n_rows * t / n_threads,
+                                                         n_rows * (t + 1) / n_threads, bs);
+                                    } });
+        };
+
+        // The interior rows only require the owned values of x,
+        // so they are computed while the ghost values are exchanged
+        x.update_ghosts_begin();
+        multiply_rows(A.matrix()->interior_rows());
+        x.update_ghosts_end();
+        multiply_rows(A.matrix()->boundary_rows());
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + im->n_owned() * bs, y.values().end(), 0.0);
+    }
+}
\ No newline at end of file
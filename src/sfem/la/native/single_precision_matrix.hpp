@@ -0,0 +1,57 @@
+#pragma once
+
+#include <sfem/la/native/linear_operator.hpp>
+#include <sfem/graph/connectivity.hpp>
+#include <vector>
+
+namespace sfem::la
+{
+    /// @brief Sparse matrix with values stored in single precision (CSR format, same block
+    /// layout as SparseMatrix), while the vectors and the accumulation of the products remain
+    /// in working precision (real_t). Since the SpMV is bandwidth-bound, this roughly halves
+    /// its memory traffic for double precision builds, at the cost of an O(1e-7) relative
+    /// perturbation of the matrix entries, e.g. for the inner solves of IterativeRefinement.
+    ///
+    /// A SinglePrecisionMatrix is a copy of an assembled SparseMatrix, with the same sparsity
+    /// and index maps. The SparseMatrix remains the target of assembly, and is returned by
+    /// matrix(), so that preconditioners are set up from the original entries
+    /// @note The matrix is referenced, thus it must outlive the SinglePrecisionMatrix
+    class SinglePrecisionMatrix : public LinearOperator
+    {
+    public:
+        /// @brief Create a SinglePrecisionMatrix
+        /// @param A Sparse matrix (square)
+        SinglePrecisionMatrix(const SparseMatrix &A);
+
+        /// @brief Copy (and round) the values of the sparse matrix, e.g. after re-assembly
+        void update_values();
+
+        /// @brief Get the row-to-column connectivity
+        std::shared_ptr<const graph::Connectivity> connectivity() const;
+
+        /// @brief Get the matrix values
+        const std::vector<float> &values() const;
+
+        std::shared_ptr<const IndexMap> index_map() const override;
+
+        int block_size() const override;
+
+        void apply(Vector &x, Vector &y) const override;
+
+        void diagonal(Vector &diag) const override;
+
+        const SparseMatrix *matrix() const override;
+
+    private:
+        /// @brief Sparse matrix
+        const SparseMatrix &A_;
+
+        /// @brief Matrix values (single precision)
+        std::vector<float> values_;
+    };
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax, with the ghost value update of x
+    /// overlapped with the multiplication of the interior rows
+    /// @note Updates the ghost index values of x
+    void spmv_overlap(const SinglePrecisionMatrix &A, Vector &x, Vector &y);
+}
\ No newline at end of file
@@ -1,12 +1,135 @@
 #include "sparse_matrix.hpp"
 #include <sfem/la/native/vector.hpp>
+#include <sfem/la/native/block_dispatch.hpp>
 #include <sfem/parallel/mpi.hpp>
+#include <sfem/parallel/omp.hpp>
 #include <sfem/base/error.hpp>
 #include <cmath>
 #include <numeric>
 
 namespace sfem::la
 {
+    //=============================================================================
+    /// @brief Add a row-major array of element values to the matrix values.
+    /// BS is the block size, or 0 if it is only known at runtime (bs_runtime)
+    template <int BS>
+    static void add_element_values(const graph::Connectivity &row_to_col,
+                                   std::span<const int> row_idxs,
+                                   std::span<const int> col_idxs,
+                                   std::span<const real_t> values,
+                                   real_t *a,
+                                   int bs_runtime)
+    {
+        const int bs = BS > 0 ? BS : bs_runtime;
+        const int nr = static_cast<int>(row_idxs.size());
+        const int nc = static_cast<int>(col_idxs.size());
+        const int stride = nc * bs;
+        for (int i = 0; i < nr; i++)
+        {
+            const int r = row_idxs[i];
+            const int offset = row_to_col.offset(r);
+            const real_t *vr = values.data() + i * stride * bs;
+            for (int j = 0; j < nc; j++)
+            {
+                const int rel_idx = row_to_col.relative_index(r, col_idxs[j]);
+                real_t *ab = a + (offset + rel_idx) * bs * bs;
+                const real_t *vb = vr + j * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        ab[k1 * bs + k2] += vb[k1 * stride + k2];
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    /// @brief Add a row-major array of element values to the matrix values at the given block positions.
+    /// BS is the block size, or 0 if it is only known at runtime (bs_runtime)
+    template <int BS>
+    static void add_block_values(std::span<const int> block_idxs,
+                                 int nc,
+                                 std::span<const real_t> values,
+                                 real_t *a,
+                                 int bs_runtime)
+    {
+        const int bs = BS > 0 ? BS : bs_runtime;
+        const int nr = static_cast<int>(block_idxs.size()) / nc;
+        const int stride = nc * bs;
+        for (int i = 0; i < nr; i++)
+        {
+            const real_t *vr = values.data() + i * stride * bs;
+            for (int j = 0; j < nc; j++)
+            {
+                real_t *ab = a + block_idxs[i * nc + j] * bs * bs;
+                const real_t *vb = vr + j * bs;
+                for (int k1 = 0; k1 < bs; k1++)
+                {
+                    for (int k2 = 0; k2 < bs; k2++)
+                    {
+                        ab[k1 * bs + k2] += vb[k1 * stride + k2];
+                    }
+                }
+            }
+        }
+    }
+    //=============================================================================
+    /// @brief Compute y = Ax for the rows in [row_begin, row_end), or for the rows
+    /// rows[row_begin], ..., rows[row_end - 1] if a row list is given.
+    /// BS is the block size, or 0 if it is only known at runtime (bs_runtime)
+    template <int BS>
+    static void spmv_rows(const graph::Connectivity &row_to_col,
+                          const real_t *a,
+                          const real_t *x,
+                          real_t *y,
+                          const int *rows,
+                          int row_begin,
+                          int row_end,
+                          int bs_runtime)
+    {
+        const int bs = BS > 0 ? BS : bs_runtime;
+        for (int k = row_begin; k < row_end; k++)
+        {
+            const int r = rows ? rows[k] : k;
+            const auto cols = row_to_col.links(r);
+            const real_t *ar = a + row_to_col.offset(r) * bs * bs;
+            real_t *yr = y + r * bs;
+            if constexpr (BS > 0)
+            {
+                std::array<real_t, BS> acc{};
+                for (std::size_t c = 0; c < cols.size(); c++)
+                {
+                    const real_t *ac = ar + c * BS * BS;
+                    const real_t *xc = x + cols[c] * BS;
+                    for (int k1 = 0; k1 < BS; k1++)
+                    {
+                        for (int k2 = 0; k2 < BS; k2++)
+                        {
+                            acc[k1] += ac[k1 * BS + k2] * xc[k2];
+                        }
+                    }
+                }
+                std::copy(acc.cbegin(), acc.cend(), yr);
+            }
+            else
+            {
+                std::fill(yr, yr + bs, 0.0);
+                for (std::size_t c = 0; c < cols.size(); c++)
+                {
+                    const real_t *ac = ar + c * bs * bs;
+                    const real_t *xc = x + cols[c] * bs;
+                    for (int k1 = 0; k1 < bs; k1++)
+                    {
+                        for (int k2 = 0; k2 < bs; k2++)
+                        {
+                            yr[k1] += ac[k1 * bs + k2] * xc[k2];
+                        }
+                    }
+                }
+            }
+        }
+    }
     //=============================================================================
     SparseMatrix::SparseMatrix(std::shared_ptr<const graph::Connectivity> row_to_col,
                                std::shared_ptr<const IndexMap> row_index_map,
@@ -16,10 +139,42 @@ namespace sfem::la
           row_im_(row_index_map),
           col_im_(col_index_map),
           values_(row_to_col_->n_links() * block_size * block_size, 0.0),
-          bs_(block_size)
+          bs_(block_size),
+          diag_idxs_(row_im_->n_owned(), -1)
     {
         SFEM_CHECK_SIZES(row_to_col_->n_primary(), row_im_->n_local());
         SFEM_CHECK_SIZES(row_to_col_->n_secondary(), col_im_->n_local());
+
+        // Locate the diagonal block of each owned row
+        if (row_im_ == col_im_)
+        {
+            for (int r = 0; r < row_im_->n_owned(); r++)
+            {
+                auto cols = row_to_col_->links(r);
+                auto it = std::find(cols.begin(), cols.end(), r);
+                if (it != cols.end())
+                {
+                    diag_idxs_[r] = row_to_col_->offset(r) + static_cast<int>(std::distance(cols.begin(), it));
+                }
+            }
+        }
+
+        // Split the owned rows into interior rows, i.e. rows that only
+        // couple to owned columns, and boundary rows
+        const int n_owned_cols = col_im_->n_owned();
+        for (int r = 0; r < row_im_->n_owned(); r++)
+        {
+            auto cols = row_to_col_->links(r);
+            if (std::all_of(cols.begin(), cols.end(), [n_owned_cols](int c)
+                            { return c < n_owned_cols; }))
+            {
+                interior_rows_.push_back(r);
+            }
+            else
+            {
+                boundary_rows_.push_back(r);
+            }
+        }
     }
     //=============================================================================
     std::shared_ptr<const graph::Connectivity>
@@ -58,29 +213,22 @@ namespace sfem::la
                                   std::span<const int> col_idxs,
                                   std::span<const real_t> values)
     {
-        const int nr = static_cast<int>(row_idxs.size());
-        const int nc = static_cast<int>(col_idxs.size());
-        SFEM_CHECK_SIZES(nr * nc * bs_ * bs_, values.size());
-        for (int i = 0; i < nr; i++)
+        SFEM_CHECK_SIZES(row_idxs.size() * col_idxs.size() * bs_ * bs_, values.size());
+        dispatch_block_size(bs_, [&]<int BS>(std::integral_constant<int, BS>)
+                            { add_element_values<BS>(*row_to_col_, row_idxs, col_idxs, values, values_.data(), bs_); });
+    }
+    //=============================================================================
+    void SparseMatrix::add_values(std::span<const int> block_idxs,
+                                  int n_cols,
+                                  std::span<const real_t> values)
+    {
+        if (n_cols < 1 or block_idxs.size() % n_cols != 0)
         {
-            const int r = row_idxs[i];
-            const int ri = i * nc * bs_ * bs_;
-            const int offset = row_to_col_->offset(r);
-            for (int j = 0; j < nc; j++)
-            {
-                const int c = col_idxs[j];
-                const int ci = j * bs_;
-                const int rel_idx = row_to_col_->relative_index(r, c);
-                const int start = (offset + rel_idx) * bs_ * bs_;
-                for (int k1 = 0; k1 < bs_; k1++)
-                {
-                    for (int k2 = 0; k2 < bs_; k2++)
-                    {
-                        values_[start + k1 * bs_ + k2] += values[ri + ci + k1 * nc * bs_ + k2];
-                    }
-                }
-            }
+            SFEM_ERROR(std::format("Cannot arrange {} blocks in {} columns\n", block_idxs.size(), n_cols));
         }
+        SFEM_CHECK_SIZES(block_idxs.size() * bs_ * bs_, values.size());
+        dispatch_block_size(bs_, [&]<int BS>(std::integral_constant<int, BS>)
+                            { add_block_values<BS>(block_idxs, n_cols, values, values_.data(), bs_); });
     }
     //=============================================================================
     std::pair<std::span<const int>, std::span<real_t>>
@@ -174,9 +322,7 @@ namespace sfem::la
         SFEM_CHECK_SIZES(bs_, diag.block_size());
         for (int r = 0; r < row_im_->n_owned(); r++)
         {
-            const int offset = row_to_col_->offset(r);
-            const int rel_idx = row_to_col_->relative_index(r, r);
-            const int start = (offset + rel_idx) * bs_ * bs_;
+            const int start = diagonal_block(r) * bs_ * bs_;
             for (int k = 0; k < bs_; k++)
             {
                 diag(r, k) = values_[start + k * bs_ + k];
@@ -190,9 +336,7 @@ namespace sfem::la
         SFEM_CHECK_INDEX(src_comp, bs_);
         for (int r = 0; r < row_im_->n_owned(); r++)
         {
-            const int offset = row_to_col_->offset(r);
-            const int rel_idx = row_to_col_->relative_index(r, r);
-            const int start = (offset + rel_idx) * bs_ * bs_;
+            const int start = diagonal_block(r) * bs_ * bs_;
             diag(r, dest_comp) = values_[start + src_comp * bs_ + src_comp];
         }
     }
@@ -201,9 +345,7 @@ namespace sfem::la
     {
         for (int r = 0; r < row_im_->n_owned(); r++)
         {
-            const int offset = row_to_col_->offset(r);
-            const int rel_idx = row_to_col_->relative_index(r, r);
-            const int start = (offset + rel_idx) * bs_ * bs_;
+            const int start = diagonal_block(r) * bs_ * bs_;
             for (int k = 0; k < bs_; k++)
             {
                 values_[start + k * bs_ + k] *= a;
@@ -211,6 +353,42 @@ namespace sfem::la
         }
     }
     //=============================================================================
+    std::span<const int> SparseMatrix::diagonal_idxs() const
+    {
+        return diag_idxs_;
+    }
+    //=============================================================================
+    int SparseMatrix::diagonal_block(int row_idx) const
+    {
+        if (diag_idxs_[row_idx] < 0)
+        {
+            SFEM_ERROR(std::format("Row {} has no diagonal entry\n", row_idx));
+        }
+        return diag_idxs_[row_idx];
+    }
+    //=============================================================================
+    const std::vector<int> &SparseMatrix::row_blocks() const
+    {
+        const int n_blocks = omp::n_threads();
+        if (static_cast<int>(row_blocks_.size()) != n_blocks + 1)
+        {
+            const auto offsets = row_to_col_->offsets();
+            row_blocks_ = omp::balanced_partition(std::span(offsets).first(row_im_->n_owned() + 1),
+                                                  n_blocks);
+        }
+        return row_blocks_;
+    }
+    //=============================================================================
+    std::span<const int> SparseMatrix::interior_rows() const
+    {
+        return interior_rows_;
+    }
+    //=============================================================================
+    std::span<const int> SparseMatrix::boundary_rows() const
+    {
+        return boundary_rows_;
+    }
+    //=============================================================================
     real_t norm(const SparseMatrix &A)
     {
         real_t norm = std::accumulate(A.values().cbegin(),
@@ -233,20 +411,68 @@ namespace sfem::la
         SFEM_CHECK_SIZES(bs, x.block_size());
         SFEM_CHECK_SIZES(bs, y.block_size());
 
-        y.set_all(0.0);
-        for (int r = 0; r < row_im->n_owned(); r++)
+        const auto row_to_col = A.connectivity();
+        const auto &row_blocks = A.row_blocks();
+        const int n_blocks = static_cast<int>(row_blocks.size()) - 1;
+        const real_t *a = A.values().data();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+
+        dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                            {
+                                SFEM_OMP(parallel for schedule(static, 1))
+                                for (int b = 0; b < n_blocks; b++)
+                                {
+                                    spmv_rows<BS>(*row_to_col, a, xv, yv, nullptr,
+                                                  row_blocks[b], row_blocks[b + 1], bs);
+                                } });
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + row_im->n_owned() * bs, y.values().end(), 0.0);
+    }
+    //=============================================================================
+    void spmv_overlap(const SparseMatrix &A,
+                      Vector &x,
+                      Vector &y)
+    {
+        const int bs = A.block_size();
+        const auto row_im = A.index_maps()[0];
+        const auto col_im = A.index_maps()[1];
+
+        SFEM_CHECK_SIZES(row_im->n_owned(), y.index_map()->n_owned());
+        SFEM_CHECK_SIZES(col_im->n_owned(), x.index_map()->n_owned());
+        SFEM_CHECK_SIZES(bs, x.block_size());
+        SFEM_CHECK_SIZES(bs, y.block_size());
+
+        const auto row_to_col = A.connectivity();
+        const real_t *a = A.values().data();
+        const real_t *xv = x.values().data();
+        real_t *yv = y.values().data();
+        const int n_threads = omp::n_threads();
+
+        // Compute y = Ax for a list of rows, split evenly among the threads
+        auto multiply_rows = [&](std::span<const int> rows)
         {
-            const auto [cols, values] = A.row_data(r);
-            for (std::size_t c = 0; c < cols.size(); c++)
-            {
-                for (int k1 = 0; k1 < bs; k1++)
-                {
-                    for (int k2 = 0; k2 < bs; k2++)
-                    {
-                        y(r, k1) += x(cols[c], k2) * values[c * bs * bs + k1 * bs + k2];
-                    }
-                }
-            }
-        }
+            const int n_rows = static_cast<int>(rows.size());
+            dispatch_block_size(bs, [&]<int BS>(std::integral_constant<int, BS>)
+                                {
+                                    SFEM_OMP(parallel for schedule(static, 1))
+                                    for (int t = 0; t < n_threads; t++)
+                                    {
+                                        spmv_rows<BS>(*row_to_col, a, xv, yv, rows.data(),
+                                                      n_rows * t / n_threads,
+                                                      n_rows * (t + 1) / n_threads, bs);
+                                    } });
+        };
+
+        // The interior rows only require the owned values of x,
+        // so they are computed while the ghost values are exchanged
+        x.update_ghosts_begin();
+        multiply_rows(A.interior_rows());
+        x.update_ghosts_end();
+        multiply_rows(A.boundary_rows());
+
+        // Ghost values are not computed
+        std::fill(y.values().begin() + row_im->n_owned() * bs, y.values().end(), 0.0);
     }
 }
\ No newline at end of file
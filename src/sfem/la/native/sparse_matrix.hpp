@@ -55,6 +55,16 @@ namespace sfem::la
                         std::span<const int> col_idxs,
                         std::span<const real_t> values);
 
+        /// @brief Add matrix values at precomputed block positions,
+        /// i.e. without searching for the column indices in each row
+        /// @param block_idxs Block positions in the row-to-column connectivity array,
+        /// for n_rows x n_cols blocks in row-major order
+        /// @param n_cols Number of block columns
+        /// @param values Values (same layout as for set_values)
+        void add_values(std::span<const int> block_idxs,
+                        int n_cols,
+                        std::span<const real_t> values);
+
         /// @brief Get the (local) column indices and a values for a given row
         /// @param row_idx Local row index
         std::pair<std::span<const int>, std::span<real_t>>
@@ -78,7 +88,29 @@ namespace sfem::la
         /// @brief Scale the diagonal entries of the matrix
         void scale_diagonal(real_t a);
 
+        /// @brief Get the block positions (in the values array, in units of blocks)
+        /// of the diagonal blocks of the owned rows
+        /// @note The position is -1 for rows without a diagonal block,
+        /// and for all rows if the row and column index maps differ
+        std::span<const int> diagonal_idxs() const;
+
+        /// @brief Get the partition of the owned rows into contiguous blocks
+        /// with (approximately) equal number of non-zeros, one block per thread
+        /// @note The partition is recomputed if the number of threads has changed
+        const std::vector<int> &row_blocks() const;
+
+        /// @brief Get the owned rows that only have owned columns,
+        /// i.e. rows that can be multiplied without ghost values
+        std::span<const int> interior_rows() const;
+
+        /// @brief Get the owned rows that have at least one ghost column
+        std::span<const int> boundary_rows() const;
+
     private:
+        /// @brief Get the block position of the diagonal block of an owned row
+        /// @note Raises an error if the row has no diagonal block
+        int diagonal_block(int row_idx) const;
+
         /// @brief Row-to-column connectivity
         std::shared_ptr<const graph::Connectivity> row_to_col_;
 
@@ -93,6 +125,16 @@ namespace sfem::la
 
         /// @brief Block size
         int bs_;
+
+        /// @brief Block positions of the diagonal blocks of the owned rows
+        std::vector<int> diag_idxs_;
+
+        /// @brief Boundaries of the nnz-balanced (owned) row blocks
+        mutable std::vector<int> row_blocks_;
+
+        /// @brief Owned rows without and with ghost columns
+        std::vector<int> interior_rows_;
+        std::vector<int> boundary_rows_;
     };
 
     /// @brief Compute the Frobenius norm for a matrix
@@ -101,4 +143,9 @@ namespace sfem::la
     /// @brief Sparse matrix-vector multiplication: y = Ax
     /// @note The ghost index values of x should be updated before calling
     void spmv(const SparseMatrix &A, const Vector &x, Vector &y);
+
+    /// @brief Sparse matrix-vector multiplication: y = Ax, with the ghost value update of x
+    /// overlapped with the multiplication of the interior rows
+    /// @note Updates the ghost index values of x
+    void spmv_overlap(const SparseMatrix &A, Vector &x, Vector &y);
 }
\ No newline at end of file
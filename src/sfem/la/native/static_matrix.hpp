@@ -0,0 +1,168 @@
+#pragma once
+
+#include <sfem/base/config.hpp>
+#include <sfem/base/error.hpp>
+#include <array>
+#include <span>
+#include <format>
+
+namespace sfem::la
+{
+    /// @brief Dense matrix with compile-time dimensions and stack storage (row-major),
+    /// intended for element-level computations with small, fixed-size matrices
+    /// @tparam R Number of rows
+    /// @tparam C Number of columns
+    template <int R, int C>
+    class StaticMatrix
+    {
+    public:
+        static_assert(R > 0 and C > 0, "StaticMatrix dimensions must be positive");
+
+        /// @brief Create a StaticMatrix
+        /// @param value Uniform value
+        explicit StaticMatrix(real_t value = 0.0)
+        {
+            values_.fill(value);
+        }
+
+        /// @brief Create a StaticMatrix from row-major values, e.g. those of a DenseMatrix
+        /// @param values Matrix values
+        explicit StaticMatrix(std::span<const real_t> values)
+        {
+            SFEM_CHECK_SIZES(R * C, values.size());
+            for (int i = 0; i < R * C; i++)
+            {
+                values_[i] = values[i];
+            }
+        }
+
+        /// @brief Get the number of rows
+        static constexpr int n_rows()
+        {
+            return R;
+        }
+
+        /// @brief Get the number of columns
+        static constexpr int n_cols()
+        {
+            return C;
+        }
+
+        /// @brief Get the matrix values
+        std::span<real_t, R * C> values()
+        {
+            return values_;
+        }
+
+        /// @brief Get the matrix values (const version)
+        std::span<const real_t, R * C> values() const
+        {
+            return values_;
+        }
+
+        /// @brief Set all matrix values to a uniform value
+        void set_all(real_t value)
+        {
+            values_.fill(value);
+        }
+
+        /// @brief Get the value at a given index pair
+        real_t &operator()(int i, int j)
+        {
+            return values_[i * C + j];
+        }
+
+        /// @brief Get the value at a given index pair (const version)
+        real_t operator()(int i, int j) const
+        {
+            return values_[i * C + j];
+        }
+
+    private:
+        /// @brief Values
+        std::array<real_t, R * C> values_;
+    };
+
+    /// @brief Get the transpose of a matrix
+    template <int R, int C>
+    StaticMatrix<C, R> transpose(const StaticMatrix<R, C> &A)
+    {
+        StaticMatrix<C, R> At;
+        for (int i = 0; i < R; i++)
+        {
+            for (int j = 0; j < C; j++)
+            {
+                At(j, i) = A(i, j);
+            }
+        }
+        return At;
+    }
+
+    /// @brief Matrix multiplication
+    template <int R, int K, int C>
+    StaticMatrix<R, C> operator*(const StaticMatrix<R, K> &lhs, const StaticMatrix<K, C> &rhs)
+    {
+        StaticMatrix<R, C> result;
+        for (int i = 0; i < R; i++)
+        {
+            for (int k = 0; k < K; k++)
+            {
+                const real_t lhs_ik = lhs(i, k);
+                for (int j = 0; j < C; j++)
+                {
+                    result(i, j) += lhs_ik * rhs(k, j);
+                }
+            }
+        }
+        return result;
+    }
+
+    /// @brief Accumulate the product of the form a * B^T * D * B, i.e. K += a * B^T * D * B,
+    /// without forming B^T or any other temporary besides D * B
+    /// @param B Matrix of size S x N (e.g. strain-displacement matrix)
+    /// @param D Matrix of size S x S (e.g. stress-strain matrix)
+    /// @param a Scalar (e.g. integration weight)
+    /// @param K Matrix of size N x N (e.g. element stiffness matrix)
+    template <int S, int N>
+    void add_BtDB(const StaticMatrix<S, N> &B,
+                  const StaticMatrix<S, S> &D,
+                  real_t a,
+                  StaticMatrix<N, N> &K)
+    {
+        const StaticMatrix<S, N> DB = D * B;
+        for (int k = 0; k < S; k++)
+        {
+            for (int i = 0; i < N; i++)
+            {
+                const real_t aBki = a * B(k, i);
+                for (int j = 0; j < N; j++)
+                {
+                    K(i, j) += aBki * DB(k, j);
+                }
+            }
+        }
+    }
+
+    /// @brief Accumulate the product of the form a * B^T * B, i.e. K += a * B^T * B,
+    /// without forming B^T (e.g. add_BtDB with D = I)
+    /// @param B Matrix of size S x N (e.g. shape function gradients)
+    /// @param a Scalar (e.g. integration weight)
+    /// @param K Matrix of size N x N (e.g. element stiffness matrix)
+    template <int S, int N>
+    void add_BtB(const StaticMatrix<S, N> &B,
+                 real_t a,
+                 StaticMatrix<N, N> &K)
+    {
+        for (int k = 0; k < S; k++)
+        {
+            for (int i = 0; i < N; i++)
+            {
+                const real_t aBki = a * B(k, i);
+                for (int j = 0; j < N; j++)
+                {
+                    K(i, j) += aBki * B(k, j);
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
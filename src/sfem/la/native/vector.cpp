@@ -1,5 +1,6 @@
 #include "vector.hpp"
 #include <sfem/parallel/mpi.hpp>
+#include <sfem/parallel/omp.hpp>
 #include <sfem/base/error.hpp>
 #include <algorithm>
 #include <cmath>
@@ -111,18 +112,24 @@ namespace sfem::la
     //=============================================================================
     void Vector::assemble()
     {
-        scatterer_->reverse(values_, bs_,
-                            [](real_t &dest, real_t src)
-                            { dest += src; });
+        scatterer_->reverse(values_, bs_, AddOp{});
         // Set ghost values to zero
         std::fill(values_.begin() + n_owned() * bs_, values_.end(), 0.0);
     }
     //=============================================================================
     void Vector::update_ghosts()
     {
-        scatterer_->forward(values_, bs_,
-                            [](real_t &dest, real_t src)
-                            { dest = src; });
+        scatterer_->forward(values_, bs_, InsertOp{});
+    }
+    //=============================================================================
+    void Vector::update_ghosts_begin()
+    {
+        scatterer_->forward_begin(values_, bs_);
+    }
+    //=============================================================================
+    void Vector::update_ghosts_end()
+    {
+        scatterer_->forward_end(values_, bs_, InsertOp{});
     }
     //=============================================================================
     void copy(const Vector &src, Vector &dest)
@@ -136,6 +143,7 @@ namespace sfem::la
     //=============================================================================
     void scale(real_t a, Vector &x)
     {
+        SFEM_OMP(parallel for)
         for (int i = 0; i < x.n_owned(); i++)
         {
             for (int j = 0; j < x.block_size(); j++)
@@ -149,6 +157,7 @@ namespace sfem::la
     {
         SFEM_CHECK_SIZES(x.block_size(), y.block_size());
         SFEM_CHECK_SIZES(x.n_owned(), y.n_owned());
+        SFEM_OMP(parallel for)
         for (int i = 0; i < x.n_owned(); i++)
         {
             for (int j = 0; j < x.block_size(); j++)
@@ -165,6 +174,7 @@ namespace sfem::la
         SFEM_CHECK_SIZES(x.n_owned(), z.n_owned());
         SFEM_CHECK_SIZES(x.block_size(), y.block_size());
         SFEM_CHECK_SIZES(x.block_size(), z.block_size());
+        SFEM_OMP(parallel for)
         for (int i = 0; i < x.n_owned(); i++)
         {
             for (int j = 0; j < x.block_size(); j++)
@@ -179,9 +189,15 @@ namespace sfem::la
     {
         SFEM_CHECK_SIZES(x.block_size(), y.block_size());
         SFEM_CHECK_SIZES(x.n_owned(), y.n_owned());
-        real_t prod = std::inner_product(x.values().cbegin(),
-                                         x.values().cbegin() + x.n_owned() * x.block_size(),
-                                         y.values().cbegin(), 0.0);
+        const int n = x.n_owned() * x.block_size();
+        const real_t *xv = x.values().data();
+        const real_t *yv = y.values().data();
+        real_t prod = 0.0;
+        SFEM_OMP(parallel for reduction(+ : prod))
+        for (int i = 0; i < n; i++)
+        {
+            prod += xv[i] * yv[i];
+        }
         return mpi::reduce(prod, mpi::ReduceOperation::sum);
     }
     //=============================================================================
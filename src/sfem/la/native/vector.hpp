@@ -93,6 +93,15 @@ namespace sfem::la
         /// @brief Update the values of ghost indices
         void update_ghosts();
 
+        /// @brief Start updating the values of ghost indices, without waiting for
+        /// the communication to complete
+        /// @note The ghost values must not be accessed until update_ghosts_end() is called
+        void update_ghosts_begin();
+
+        /// @brief Complete an update of the values of ghost indices
+        /// started with update_ghosts_begin()
+        void update_ghosts_end();
+
     protected:
         /// @brief Index map
         std::shared_ptr<const IndexMap> im_;
@@ -6,6 +6,7 @@
 #include <sfem/la/petsc/petsc_ksp.hpp>
 #include <sfem/la/native/sparsity.hpp>
 #include <sfem/la/native/vector.hpp>
+#include <sfem/parallel/omp.hpp>
 #include <sfem/base/logging.hpp>
 #include <format>
 
@@ -160,9 +161,12 @@ namespace sfem::la::petsc
     //=============================================================================
     VecSet create_vecset(la::petsc::PetscVec &vec)
     {
+        // PETSc is not thread-safe, thus concurrent calls
+        // (e.g. from colored assembly loops) are serialized
         return [&vec](std::span<const int> idxs,
                       std::span<const real_t> values)
         {
+            SFEM_OMP(critical(sfem_petsc_setval))
             vec.set_values(idxs, values);
         };
     }
@@ -173,6 +177,7 @@ namespace sfem::la::petsc
                       std::span<const int> col_idxs,
                       std::span<const real_t> values)
         {
+            SFEM_OMP(critical(sfem_petsc_setval))
             mat.set_values(row_idxs, col_idxs, values);
         };
     }
@@ -74,6 +74,9 @@ namespace sfem::la::petsc
         case SolverType::cg:
             ksp_type = KSPCG;
             break;
+        case SolverType::pipecg:
+            ksp_type = KSPPIPECG;
+            break;
         default:
             ksp_type = KSPGMRES;
             break;
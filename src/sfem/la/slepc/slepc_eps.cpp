@@ -141,15 +141,15 @@ namespace sfem::la::slepc
             SFEM_ERROR(std::format("Eigenpair {} is not available\n", pair_idx));
         }
 
-        // Get operator local and global sizes
+        // Create vectors compatible with the operator
         Mat mat;
-        int n_local, n_global;
+        Vec vec;
         EPSGetOperators(eps_, &mat, nullptr);
-        MatGetSize(mat, &n_global, &n_local);
+        MatCreateVecs(mat, &vec, nullptr);
 
         // Get the eigenvalue and its corresponding eigenvector
         real_t real, imag;
-        auto V_real = petsc::create_vec(IndexMap(n_local), 1);
+        auto V_real = petsc::PetscVec(vec, false);
         auto V_imag = V_real.copy();
         EPSGetEigenpair(eps_, pair_idx,
                         &real, &imag,
@@ -68,14 +68,21 @@ namespace sfem::mesh
     //=============================================================================
     std::vector<std::array<real_t, 3>>
     Mesh::entity_points(int entity_idx, int dim) const
+    {
+        std::vector<std::array<real_t, 3>> entity_points;
+        this->entity_points(entity_idx, dim, entity_points);
+        return entity_points;
+    }
+    //=============================================================================
+    void Mesh::entity_points(int entity_idx, int dim,
+                             std::vector<std::array<real_t, 3>> &points) const
     {
         auto entity_nodes = topology_->adjacent_entities(entity_idx, dim, 0);
-        std::vector<std::array<real_t, 3>> entity_points(entity_nodes.size());
-        for (std::size_t i = 0; i < entity_points.size(); i++)
+        points.resize(entity_nodes.size());
+        for (std::size_t i = 0; i < points.size(); i++)
         {
-            entity_points[i] = points_[entity_nodes[i]];
+            points[i] = points_[entity_nodes[i]];
         }
-        return entity_points;
     }
     //=============================================================================
     Region Mesh::get_region_by_name(const std::string &region_name) const
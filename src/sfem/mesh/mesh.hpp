@@ -58,6 +58,13 @@ namespace sfem::mesh
         std::vector<std::array<real_t, 3>>
         entity_points(int entity_idx, int dim) const;
 
+        /// @brief Get the coordinates of an entity's nodes, reusing an existing vector
+        /// @param entity_idx The entity's index
+        /// @param dim The entity's topological dimension
+        /// @param points The entity's points
+        void entity_points(int entity_idx, int dim,
+                           std::vector<std::array<real_t, 3>> &points) const;
+
         /// @brief Get a region by its name
         Region get_region_by_name(const std::string &region_name) const;
 
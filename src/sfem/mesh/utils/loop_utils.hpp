@@ -1,6 +1,9 @@
 #pragma once
 
 #include <sfem/mesh/mesh.hpp>
+#include <sfem/graph/connectivity.hpp>
+#include <sfem/parallel/omp.hpp>
+#include <algorithm>
 
 namespace sfem::mesh::utils
 {
@@ -40,6 +43,176 @@ namespace sfem::mesh::utils
         }
     }
 
+    /// @brief Get the region with a given tag, or nullptr if no region has the tag
+    inline const Region *find_region(const Mesh &mesh, int tag)
+    {
+        for (const auto &region : mesh.regions())
+        {
+            if (region.tag() == tag)
+            {
+                return &region;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Loop over the entities of a mesh one color at a time, processing
+    /// the entities of each color in parallel
+    /// @param mesh Mesh
+    /// @param func Function to be executed for every entity
+    /// @param colors Color-to-entity connectivity
+    /// @param dim Entity dimension
+    /// @param skip_ghost Whether to skip ghost entities
+    /// @param skip_region Predicate for regions whose entities are skipped
+    inline void for_all_colored_entities(const Mesh &mesh, MeshLoopFunc auto &&func,
+                                         const graph::Connectivity &colors, int dim,
+                                         bool skip_ghost, auto &&skip_region)
+    {
+        const auto topology = mesh.topology();
+        const auto index_map = topology->entity_index_map(dim);
+        for (int color = 0; color < colors.n_primary(); color++)
+        {
+            const auto entities = colors.links(color);
+            const int n_entities = static_cast<int>(entities.size());
+
+            SFEM_OMP(parallel for schedule(dynamic, 64))
+            for (int i = 0; i < n_entities; i++)
+            {
+                const int entity_idx = entities[i];
+
+                // Skip ghost entities if required
+                if (skip_ghost and index_map->is_ghost(entity_idx))
+                {
+                    continue;
+                }
+
+                const Cell entity = topology->entity(entity_idx, dim);
+                const Region *region = find_region(mesh, entity.tag);
+                if (region == nullptr or skip_region(*region))
+                {
+                    continue;
+                }
+
+                // Do work
+                func(mesh, *region, entity, entity_idx);
+            }
+        }
+    }
+
+    /// @brief Loop over the cells of a mesh in parallel, one color at a time.
+    /// The cells of a color are distributed among the threads, thus func may only
+    /// modify data that is not shared by cells of the same color (e.g. matrix rows)
+    /// @param mesh Mesh
+    /// @param func Function to be executed for every cell
+    /// @param colors Color-to-cell connectivity (see graph::greedy_coloring)
+    /// @param skip_ghost Whether to skip ghost cells
+    inline void for_all_cells(const Mesh &mesh, MeshLoopFunc auto &&func,
+                              const graph::Connectivity &colors, bool skip_ghost = true)
+    {
+        const int cell_dim = mesh.pdim();
+        for_all_colored_entities(mesh, func, colors, cell_dim, skip_ghost,
+                                 [cell_dim](const Region &region)
+                                 { return region.dim() < cell_dim; });
+    }
+
+    template <typename F>
+    concept MeshBatchLoopFunc = std::invocable<F, const Mesh &, CellType, std::span<const int>>;
+
+    /// @brief Batch of cells of the same type
+    struct CellBatch
+    {
+        /// @brief Cell type
+        CellType type;
+
+        /// @brief Cell indices
+        std::vector<int> cells;
+    };
+
+    /// @brief Split the cells of each color into batches of cells of the same type,
+    /// sorted by type and index. Cells of boundary regions are skipped
+    /// @param mesh Mesh
+    /// @param colors Color-to-cell connectivity (see graph::greedy_coloring)
+    /// @param batch_size Maximum number of cells per batch
+    /// @param skip_ghost Whether to skip ghost cells
+    /// @return The batches of each color
+    inline std::vector<std::vector<CellBatch>>
+    create_cell_batches(const Mesh &mesh, const graph::Connectivity &colors,
+                        int batch_size = 64, bool skip_ghost = true)
+    {
+        const int cell_dim = mesh.pdim();
+        const auto topology = mesh.topology();
+        const auto index_map = topology->entity_index_map(cell_dim);
+
+        auto cell_type = [&](int cell_idx)
+        { return topology->entity(cell_idx, cell_dim).type; };
+
+        std::vector<std::vector<CellBatch>> batches(colors.n_primary());
+        std::vector<int> cells;
+        for (int color = 0; color < colors.n_primary(); color++)
+        {
+            cells.clear();
+            for (int cell_idx : colors.links(color))
+            {
+                // Skip ghost cells if required
+                if (skip_ghost and index_map->is_ghost(cell_idx))
+                {
+                    continue;
+                }
+
+                // Skip boundary regions
+                const Region *region = find_region(mesh, topology->entity(cell_idx, cell_dim).tag);
+                if (region == nullptr or region->dim() < cell_dim)
+                {
+                    continue;
+                }
+
+                cells.push_back(cell_idx);
+            }
+
+            std::sort(cells.begin(), cells.end(), [&](int lhs, int rhs)
+                      { return std::pair(cell_type(lhs), lhs) < std::pair(cell_type(rhs), rhs); });
+
+            int batch_start = 0;
+            for (int i = 1; i <= static_cast<int>(cells.size()); i++)
+            {
+                if (i == static_cast<int>(cells.size()) or
+                    i - batch_start == batch_size or
+                    cell_type(cells[i]) != cell_type(cells[i - 1]))
+                {
+                    batches[color].push_back({cell_type(cells[batch_start]),
+                                              std::vector<int>(cells.begin() + batch_start,
+                                                               cells.begin() + i)});
+                    batch_start = i;
+                }
+            }
+        }
+
+        return batches;
+    }
+
+    /// @brief Loop over batches of cells of the same type in parallel, one color at a time.
+    /// The batches of a color are distributed among the threads, thus func may only
+    /// modify data that is not shared by cells of the same color (e.g. matrix rows)
+    /// @param mesh Mesh
+    /// @param func Function to be executed for every batch, given the cell type and the cell indices
+    /// @param batches The batches of each color (see create_cell_batches), which should be
+    /// computed once and reused, e.g. those of fem::FESpace::cell_batches()
+    inline void for_all_cell_batches(const Mesh &mesh, MeshBatchLoopFunc auto &&func,
+                                     const std::vector<std::vector<CellBatch>> &batches)
+    {
+        for (const auto &color_batches : batches)
+        {
+            const int n_batches = static_cast<int>(color_batches.size());
+
+            SFEM_OMP(parallel for schedule(dynamic))
+            for (int i = 0; i < n_batches; i++)
+            {
+                const auto &batch = color_batches[i];
+                func(mesh, batch.type, std::span<const int>(batch.cells));
+            }
+        }
+    }
+
     /// @brief Loop over the facets of a specific region of a mesh
     /// @param mesh Mesh
     /// @param func Function to be executed for every facet
@@ -95,4 +268,22 @@ namespace sfem::mesh::utils
             // }
         }
     }
+
+    /// @brief Loop over the facets of a mesh in parallel, one color at a time.
+    /// The facets of a color are distributed among the threads, thus func may only
+    /// modify data that is not shared by facets of the same color
+    /// @param mesh Mesh
+    /// @param func Function to be executed for every facet
+    /// @param colors Color-to-facet connectivity (see graph::greedy_coloring)
+    /// @param skip_ghost Whether to skip ghost facets
+    /// @param skip_boundary Whether to skip boundary regions
+    inline void for_all_facets(const Mesh &mesh, MeshLoopFunc auto &&func,
+                               const graph::Connectivity &colors,
+                               bool skip_ghost = true, bool skip_boundary = false)
+    {
+        const int pdim = mesh.pdim();
+        for_all_colored_entities(mesh, func, colors, pdim - 1, skip_ghost,
+                                 [pdim, skip_boundary](const Region &region)
+                                 { return skip_boundary and region.dim() < pdim; });
+    }
 }
\ No newline at end of file
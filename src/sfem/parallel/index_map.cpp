@@ -11,14 +11,11 @@ namespace sfem
     IndexMap::IndexMap(int n_owned)
         : local_to_global_(n_owned),
           ghost_owners_(),
-          global_to_local_()
-
+          global_offsets_{0, n_owned},
+          global_offset_(0),
+          owned_offset_(0)
     {
-        for (int i = 0; i < n_owned; i++)
-        {
-            local_to_global_[i] = i;
-            global_to_local_[i] = i;
-        }
+        std::iota(local_to_global_.begin(), local_to_global_.end(), 0);
     }
     //=============================================================================
     IndexMap::IndexMap(std::vector<int> &&global_idxs,
@@ -26,11 +23,38 @@ namespace sfem
         : local_to_global_(std::move(global_idxs)),
           ghost_owners_(std::move(ghost_owners))
     {
-        // Create the global-to-local mapping
-        for (int i = 0; i < n_local(); i++)
+        // Gather the number of owned indices of all processes
+        const int n_own = n_owned();
+        const auto n_owned_all = mpi::all_gather<int>({&n_own, 1});
+        global_offsets_.resize(n_owned_all.size() + 1, 0);
+        std::inclusive_scan(n_owned_all.cbegin(), n_owned_all.cend(), global_offsets_.begin() + 1);
+        global_offset_ = global_offsets_[mpi::rank()];
+
+        init_global_to_local();
+    }
+    //=============================================================================
+    void IndexMap::init_global_to_local()
+    {
+        // Check whether the owned indices form a contiguous range
+        const int n_own = n_owned();
+        owned_offset_ = n_own > 0 ? local_to_global_[0] : 0;
+        for (int i = 1; i < n_own; i++)
         {
-            global_to_local_[local_to_global_[i]] = i;
+            if (local_to_global_[i] != owned_offset_ + i)
+            {
+                owned_offset_ = -1;
+                break;
+            }
+        }
+
+        // Sort the indices not covered by the owned range
+        const int start = owned_offset_ >= 0 ? n_own : 0;
+        sorted_idxs_.resize(n_local() - start);
+        for (int i = start; i < n_local(); i++)
+        {
+            sorted_idxs_[i - start] = {local_to_global_[i], i};
         }
+        std::ranges::sort(sorted_idxs_);
     }
     //=============================================================================
     int IndexMap::n_owned() const
@@ -50,14 +74,17 @@ namespace sfem
     //=============================================================================
     int IndexMap::n_global() const
     {
-        if (mpi::n_procs() == 1)
-        {
-            return n_owned();
-        }
-        else
-        {
-            return mpi::reduce(n_owned(), mpi::ReduceOperation::sum);
-        }
+        return global_offsets_.back();
+    }
+    //=============================================================================
+    int IndexMap::global_offset() const
+    {
+        return global_offset_;
+    }
+    //=============================================================================
+    std::span<const int> IndexMap::global_offsets() const
+    {
+        return global_offsets_;
     }
     //=============================================================================
     std::vector<int> IndexMap::owned_idxs() const
@@ -100,9 +127,18 @@ namespace sfem
     //=============================================================================
     int IndexMap::global_to_local(int global_idx) const
     {
-        if (global_to_local_.contains(global_idx))
+        if (owned_offset_ >= 0 and
+            global_idx >= owned_offset_ and
+            global_idx < owned_offset_ + n_owned())
+        {
+            return global_idx - owned_offset_;
+        }
+
+        auto it = std::ranges::lower_bound(sorted_idxs_, global_idx, {},
+                                           &std::pair<int, int>::first);
+        if (it != sorted_idxs_.end() and it->first == global_idx)
         {
-            return global_to_local_.at(global_idx);
+            return it->second;
         }
         else
         {
@@ -151,8 +187,7 @@ namespace sfem
     //=============================================================================
     IndexMap IndexMap::renumber() const
     {
-        // Get rank and number of process
-        int proc_rank = mpi::rank();
+        // Get number of process
         int n_procs = mpi::n_procs();
 
         // If serial, return early
@@ -167,17 +202,7 @@ namespace sfem
         std::vector<int> global_idxs(n_owned() + n_ghost());
 
         // Owned
-        {
-            // Compute the displacement for each process
-            std::vector<int> send_buffer(n_procs, n_owned());
-            std::vector<int> owners(n_procs);
-            std::ranges::iota(owners, 0);
-            auto [recv_buffer, _, __] = mpi::send_to_dest<int>(send_buffer, owners);
-
-            // Compute the renumbered owned indices
-            int disp = std::accumulate(recv_buffer.cbegin(), recv_buffer.cbegin() + proc_rank, 0);
-            std::iota(global_idxs.begin(), global_idxs.begin() + n_owned(), disp);
-        }
+        std::iota(global_idxs.begin(), global_idxs.begin() + n_owned(), global_offset_);
 
         // Ghost
         {
@@ -188,7 +213,7 @@ namespace sfem
             // Renumber the received ghost indices
             for (std::size_t i = 0; i < recv_buffer.size(); i++)
             {
-                int local_idx = global_to_local_.at(recv_buffer[i]);
+                int local_idx = global_to_local(recv_buffer[i]);
                 recv_buffer[i] = global_idxs[local_idx];
             }
 
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <span>
+#include <utility>
 
 namespace sfem
 {
@@ -12,18 +12,26 @@ namespace sfem
     /// where n_local is the total number of indices present in this process, namely
     /// the sum of the number of indices owned by this process (or n_owned) and the
     /// number of indices present on this process but owned by others (or n_ghost).
+    ///
+    /// If the owned indices form a contiguous range of global indices, as is the case
+    /// after renumber(), global-to-local lookups of owned indices are resolved by an
+    /// offset, and only the ghost indices are stored (sorted) for lookups. Otherwise,
+    /// all local indices are stored sorted.
     class IndexMap
     {
     public:
         /// @brief Create an IndexMap for serial execution
         /// @param n_owned Number of owned indices
+        /// @note The IndexMap is local to the calling process, i.e. n_global() equals
+        /// n_owned() and global_offsets() describes a single process
         IndexMap(int n_owned = 0);
 
         /// @brief Create an IndexMap
         /// @param owned_idxs Range of global indices
         /// @param ghost_owners Owner process for each ghost index
         /// @note The first (global_idxs.size() - ghost_owners.size()) indices
-        /// are considered owned, while the rest are considered ghosts
+        /// are considered owned, while the rest are considered ghosts.
+        /// Collective, the number of owned indices of each process is gathered
         IndexMap(std::vector<int> &&global_idxs,
                  std::vector<int> &&ghost_owners);
 
@@ -40,6 +48,15 @@ namespace sfem
         /// @brief Get the global number of indices
         int n_global() const;
 
+        /// @brief Get the offset of this process' owned indices,
+        /// i.e. the number of indices owned by lower-ranked processes
+        int global_offset() const;
+
+        /// @brief Get the offsets of the owned indices of all processes, i.e. process i
+        /// owns global_offsets()[i + 1] - global_offsets()[i] indices
+        /// @note Size n_procs + 1 (2 for an IndexMap created for serial execution)
+        std::span<const int> global_offsets() const;
+
         /// @brief Get the owned indices
         std::vector<int> owned_idxs() const;
 
@@ -87,7 +104,21 @@ namespace sfem
         /// @brief Owner process for each ghost index
         std::vector<int> ghost_owners_;
 
-        /// @brief Map from global to local indexing
-        std::unordered_map<int, int> global_to_local_;
+        /// @brief Offsets of the owned indices of all processes
+        std::vector<int> global_offsets_;
+
+        /// @brief Offset of this process' owned indices
+        int global_offset_;
+
+        /// @brief Create the global-to-local lookup data
+        void init_global_to_local();
+
+        /// @brief First global index of the owned range,
+        /// or -1 if the owned indices are not contiguous
+        int owned_offset_;
+
+        /// @brief Global and local index pairs, sorted by global index, for
+        /// the ghost indices (contiguous owned range) or all local indices (otherwise)
+        std::vector<std::pair<int, int>> sorted_idxs_;
     };
 }
\ No newline at end of file
@@ -116,6 +116,95 @@ namespace sfem::mpi
     }
     //=============================================================================
     template <typename T>
+    Request ireduce(std::span<T> values, ReduceOperation op)
+    {
+        Request request;
+        int error_code = MPI_Iallreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()),
+                                        to_mpi_datatype<T>(),
+                                        to_mpi_operation(op),
+                                        MPI_COMM_WORLD, &request);
+        SFEM_CHECK_MPI_ERROR(error_code);
+        return request;
+    }
+    //=============================================================================
+    void wait(Request &request)
+    {
+        int error_code = MPI_Wait(&request, MPI_STATUS_IGNORE);
+        SFEM_CHECK_MPI_ERROR(error_code);
+    }
+    //=============================================================================
+    void wait_all(std::span<Request> requests)
+    {
+        int error_code = MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+        SFEM_CHECK_MPI_ERROR(error_code);
+    }
+    //=============================================================================
+    template <typename T>
+    Request isend(std::span<const T> data, int dest, int tag)
+    {
+        Request request;
+        int error_code = MPI_Isend(data.data(), static_cast<int>(data.size()), to_mpi_datatype<T>(),
+                                   dest, tag, MPI_COMM_WORLD, &request);
+        SFEM_CHECK_MPI_ERROR(error_code);
+        return request;
+    }
+    //=============================================================================
+    template <typename T>
+    Request irecv(std::span<T> data, int source, int tag)
+    {
+        Request request;
+        int error_code = MPI_Irecv(data.data(), static_cast<int>(data.size()), to_mpi_datatype<T>(),
+                                   source, tag, MPI_COMM_WORLD, &request);
+        SFEM_CHECK_MPI_ERROR(error_code);
+        return request;
+    }
+    //=============================================================================
+    template <typename T>
+    Request send_init(std::span<const T> data, int dest, int tag)
+    {
+        Request request;
+        int error_code = MPI_Send_init(data.data(), static_cast<int>(data.size()), to_mpi_datatype<T>(),
+                                       dest, tag, MPI_COMM_WORLD, &request);
+        SFEM_CHECK_MPI_ERROR(error_code);
+        return request;
+    }
+    //=============================================================================
+    template <typename T>
+    Request recv_init(std::span<T> data, int source, int tag)
+    {
+        Request request;
+        int error_code = MPI_Recv_init(data.data(), static_cast<int>(data.size()), to_mpi_datatype<T>(),
+                                       source, tag, MPI_COMM_WORLD, &request);
+        SFEM_CHECK_MPI_ERROR(error_code);
+        return request;
+    }
+    //=============================================================================
+    void start_all(std::span<Request> requests)
+    {
+        if (requests.empty())
+        {
+            return;
+        }
+        int error_code = MPI_Startall(static_cast<int>(requests.size()), requests.data());
+        SFEM_CHECK_MPI_ERROR(error_code);
+    }
+    //=============================================================================
+    void free_all(std::span<Request> requests)
+    {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (finalized)
+        {
+            return;
+        }
+        for (auto &request : requests)
+        {
+            int error_code = MPI_Request_free(&request);
+            SFEM_CHECK_MPI_ERROR(error_code);
+        }
+    }
+    //=============================================================================
+    template <typename T>
     std::tuple<std::vector<T>, std::vector<int>, std::vector<int>>
     send_to_dest(const std::span<const T> data, const std::span<const int> dest, int bs)
     {
@@ -199,6 +288,28 @@ namespace sfem::mpi
                                   root(), MPI_COMM_WORLD);
         SFEM_CHECK_MPI_ERROR(error_code);
 
+        return recv_buffer;
+    }
+    //=============================================================================
+    template <typename T>
+    std::vector<T> all_gather(const std::span<const T> data)
+    {
+        // First gather the sizes
+        int n_send = static_cast<int>(data.size());
+        std::vector<int> recv_counts(n_procs(), 0);
+        int error_code = MPI_Allgather(&n_send, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        SFEM_CHECK_MPI_ERROR(error_code);
+
+        // Compute the recv buffer displacements
+        std::vector<int> recv_displs(n_procs(), 0);
+        std::exclusive_scan(recv_counts.cbegin(), recv_counts.cend(), recv_displs.begin(), 0);
+
+        std::vector<T> recv_buffer(std::accumulate(recv_counts.cbegin(), recv_counts.cend(), 0));
+        error_code = MPI_Allgatherv(data.data(), n_send, to_mpi_datatype<T>(),
+                                    recv_buffer.data(), recv_counts.data(), recv_displs.data(), to_mpi_datatype<T>(),
+                                    MPI_COMM_WORLD);
+        SFEM_CHECK_MPI_ERROR(error_code);
+
         return recv_buffer;
     }
 #else
@@ -238,6 +349,52 @@ namespace sfem::mpi
     }
     //=============================================================================
     template <typename T>
+    Request ireduce(std::span<T> values, ReduceOperation op)
+    {
+        return 0;
+    }
+    //=============================================================================
+    void wait(Request &request)
+    {
+    }
+    //=============================================================================
+    void wait_all(std::span<Request> requests)
+    {
+    }
+    //=============================================================================
+    template <typename T>
+    Request isend(std::span<const T> data, int dest, int tag)
+    {
+        return 0;
+    }
+    //=============================================================================
+    template <typename T>
+    Request irecv(std::span<T> data, int source, int tag)
+    {
+        return 0;
+    }
+    //=============================================================================
+    template <typename T>
+    Request send_init(std::span<const T> data, int dest, int tag)
+    {
+        return 0;
+    }
+    //=============================================================================
+    template <typename T>
+    Request recv_init(std::span<T> data, int source, int tag)
+    {
+        return 0;
+    }
+    //=============================================================================
+    void start_all(std::span<Request> requests)
+    {
+    }
+    //=============================================================================
+    void free_all(std::span<Request> requests)
+    {
+    }
+    //=============================================================================
+    template <typename T>
     std::tuple<std::vector<T>, std::vector<int>, std::vector<int>>
     send_to_dest(const std::span<const T> data, const std::span<const int> dest)
     {
@@ -249,11 +406,27 @@ namespace sfem::mpi
     {
         return {data.cbegin(), data.cend()};
     }
+    //=============================================================================
+    template <typename T>
+    std::vector<T> all_gather(const std::span<const T> data)
+    {
+        return {data.cbegin(), data.cend()};
+    }
 #endif // SFEM_HAS_MPI
     //=============================================================================
     // Explicit instantiations
     template int reduce(int, ReduceOperation);
     template real_t reduce(real_t, ReduceOperation);
+    template Request ireduce(std::span<int>, ReduceOperation);
+    template Request ireduce(std::span<real_t>, ReduceOperation);
+    template Request isend(std::span<const int>, int, int);
+    template Request isend(std::span<const real_t>, int, int);
+    template Request irecv(std::span<int>, int, int);
+    template Request irecv(std::span<real_t>, int, int);
+    template Request send_init(std::span<const int>, int, int);
+    template Request send_init(std::span<const real_t>, int, int);
+    template Request recv_init(std::span<int>, int, int);
+    template Request recv_init(std::span<real_t>, int, int);
     template std::tuple<std::vector<int>, std::vector<int>, std::vector<int>>
     send_to_dest<int>(std::span<const int>, std::span<const int>, int);
     template std::tuple<std::vector<real_t>, std::vector<int>, std::vector<int>>
@@ -262,4 +435,8 @@ namespace sfem::mpi
     distribute<int>(const std::span<const int>, const std::span<const int>);
     template std::vector<real_t>
     distribute<real_t>(const std::span<const real_t>, const std::span<const int>);
+    template std::vector<int>
+    all_gather<int>(const std::span<const int>);
+    template std::vector<real_t>
+    all_gather<real_t>(const std::span<const real_t>);
 }
\ No newline at end of file
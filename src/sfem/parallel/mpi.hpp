@@ -4,6 +4,10 @@
 #include <span>
 #include <source_location>
 
+#ifdef SFEM_HAS_MPI
+#include <mpi.h>
+#endif // SFEM_HAS_MPI
+
 /// @brief MPI-related functionality
 namespace sfem::mpi
 {
@@ -38,6 +42,67 @@ namespace sfem::mpi
     template <typename T>
     T reduce(T value, ReduceOperation op);
 
+    /// @brief Handle of a non-blocking communication
+#ifdef SFEM_HAS_MPI
+    using Request = MPI_Request;
+#else
+    using Request = int;
+#endif // SFEM_HAS_MPI
+
+    /// @brief Start a non-blocking reduce operation across all processes,
+    /// performed element-wise and in-place
+    /// @param values This process' values, overwritten with the reduced values
+    /// @param op Operation to be performed
+    /// @return Request handle
+    /// @note The values must not be accessed until the request is completed with wait()
+    template <typename T>
+    Request ireduce(std::span<T> values, ReduceOperation op);
+
+    /// @brief Wait for a non-blocking communication to complete
+    void wait(Request &request);
+
+    /// @brief Wait for a set of non-blocking communications to complete
+    void wait_all(std::span<Request> requests);
+
+    /// @brief Start a non-blocking send to a given process
+    /// @param data Data, must not be modified until the request is completed
+    /// @param dest Destination process
+    /// @param tag Message tag
+    /// @return Request handle
+    template <typename T>
+    Request isend(std::span<const T> data, int dest, int tag = 0);
+
+    /// @brief Start a non-blocking receive from a given process
+    /// @param data Receive buffer, must not be accessed until the request is completed
+    /// @param source Source process
+    /// @param tag Message tag
+    /// @return Request handle
+    template <typename T>
+    Request irecv(std::span<T> data, int source, int tag = 0);
+
+    /// @brief Create a persistent send to a given process, started with start_all()
+    /// @param data Data, sent as it is at the time the request is started
+    /// @param dest Destination process
+    /// @param tag Message tag
+    /// @return Request handle, to be released with free_all()
+    template <typename T>
+    Request send_init(std::span<const T> data, int dest, int tag = 0);
+
+    /// @brief Create a persistent receive from a given process, started with start_all()
+    /// @param data Receive buffer
+    /// @param source Source process
+    /// @param tag Message tag
+    /// @return Request handle, to be released with free_all()
+    template <typename T>
+    Request recv_init(std::span<T> data, int source, int tag = 0);
+
+    /// @brief Start a set of persistent communications
+    void start_all(std::span<Request> requests);
+
+    /// @brief Release a set of (inactive) persistent communications
+    /// @note Does nothing if MPI has already been finalized
+    void free_all(std::span<Request> requests);
+
     /// @brief Send data from all processes to all processes
     /// @param data Data
     /// @param dest Destination processes
@@ -53,4 +118,10 @@ namespace sfem::mpi
     /// @return Data belonging to this process
     template <typename T>
     std::vector<T> distribute(const std::span<const T> data, const std::span<const int> dest);
+
+    /// @brief Gather data from all processes to all processes
+    /// @param data This process' data
+    /// @return Data of all processes, concatenated in rank order
+    template <typename T>
+    std::vector<T> all_gather(const std::span<const T> data);
 }
\ No newline at end of file
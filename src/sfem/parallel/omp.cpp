@@ -0,0 +1,83 @@
+#include "omp.hpp"
+#include <sfem/base/error.hpp>
+#include <algorithm>
+#include <format>
+
+#ifdef SFEM_HAS_OPENMP
+#include <omp.h>
+#endif // SFEM_HAS_OPENMP
+
+namespace sfem::omp
+{
+#ifdef SFEM_HAS_OPENMP
+    //=============================================================================
+    int n_threads()
+    {
+        return omp_get_max_threads();
+    }
+    //=============================================================================
+    void set_n_threads(int n_threads)
+    {
+        if (n_threads < 1)
+        {
+            SFEM_ERROR(std::format("Invalid number of threads: {}\n", n_threads));
+        }
+        omp_set_num_threads(n_threads);
+    }
+    //=============================================================================
+    int thread_id()
+    {
+        return omp_get_thread_num();
+    }
+#else
+    //=============================================================================
+    int n_threads()
+    {
+        return 1;
+    }
+    //=============================================================================
+    void set_n_threads(int n_threads)
+    {
+        if (n_threads != 1)
+        {
+            log_msg("SFEM was built without OpenMP support, running with a single thread\n",
+                    true, LogLevel::warning);
+        }
+    }
+    //=============================================================================
+    int thread_id()
+    {
+        return 0;
+    }
+#endif // SFEM_HAS_OPENMP
+    //=============================================================================
+    std::vector<int> balanced_partition(std::span<const int> offsets, int n_chunks)
+    {
+        if (offsets.empty() or n_chunks < 1)
+        {
+            SFEM_ERROR(std::format("Invalid partition of {} offsets into {} chunks\n",
+                                   offsets.size(), n_chunks));
+        }
+
+        const int n_items = static_cast<int>(offsets.size()) - 1;
+        const long long work = offsets.back() - offsets.front();
+
+        std::vector<int> bounds(n_chunks + 1, n_items);
+        bounds[0] = 0;
+        for (int i = 1; i < n_chunks; i++)
+        {
+            // First item at which the cumulative work reaches the i-th fraction of the total
+            const auto target = static_cast<int>(offsets.front() + (work * i) / n_chunks);
+            auto it = std::lower_bound(offsets.begin() + bounds[i - 1], offsets.end() - 1, target);
+
+            // Split before or after the item that crosses the target, whichever is closer
+            if (it != offsets.begin() + bounds[i - 1] and target - *(it - 1) < *it - target)
+            {
+                it--;
+            }
+            bounds[i] = static_cast<int>(std::distance(offsets.begin(), it));
+        }
+
+        return bounds;
+    }
+}
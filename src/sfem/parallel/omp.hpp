@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <span>
+
+/// @brief Emit an OpenMP directive, e.g. SFEM_OMP(parallel for).
+/// Expands to nothing if SFEM is built without OpenMP support
+#ifdef SFEM_HAS_OPENMP
+#define SFEM_OMP_PRAGMA(x) _Pragma(#x)
+#define SFEM_OMP(directive) SFEM_OMP_PRAGMA(omp directive)
+#else
+#define SFEM_OMP(directive)
+#endif // SFEM_HAS_OPENMP
+
+/// @brief OpenMP-related functionality
+namespace sfem::omp
+{
+    /// @brief Get the number of threads used for parallel regions
+    int n_threads();
+
+    /// @brief Set the number of threads used for parallel regions
+    void set_n_threads(int n_threads);
+
+    /// @brief Get the calling thread's index within the current parallel region
+    int thread_id();
+
+    /// @brief Split a range of items into contiguous chunks of (approximately) equal work
+    /// @param offsets Work offsets, i.e. the work of item i is offsets[i + 1] - offsets[i]
+    /// @param n_chunks Number of chunks
+    /// @return Chunk boundaries (size n_chunks + 1), chunk i spans items [bounds[i], bounds[i + 1])
+    std::vector<int> balanced_partition(std::span<const int> offsets, int n_chunks);
+}
@@ -3,11 +3,32 @@
 #include <sfem/parallel/index_map.hpp>
 #include <sfem/parallel/mpi.hpp>
 #include <sfem/base/error.hpp>
-#include <functional>
+#include <algorithm>
 #include <memory>
+#include <type_traits>
 
 namespace sfem
 {
+    /// @brief Scatter operation that overrides the destination values with the received ones
+    struct InsertOp
+    {
+        template <typename T>
+        void operator()(T &dest, T src) const
+        {
+            dest = src;
+        }
+    };
+
+    /// @brief Scatter operation that adds the received values to the destination values
+    struct AddOp
+    {
+        template <typename T>
+        void operator()(T &dest, T src) const
+        {
+            dest += src;
+        }
+    };
+
     /// @brief This class facilitates communication of ghost index values
     /// for a given index map.
     ///
@@ -20,6 +41,12 @@ namespace sfem
     ///
     /// A reverse scatter consists of each process sending its stored ghost index
     /// values to their respective owner processes.
+    ///
+    /// Communication is point-to-point between neighbouring processes only. The
+    /// neighbours and message sizes are computed during construction. The send and
+    /// receive buffers and the persistent requests are created on first use for each
+    /// block size and reused afterwards, so that repeated scatters neither involve
+    /// all processes nor allocate memory.
     template <typename T>
     class Scatterer
     {
@@ -44,8 +71,37 @@ namespace sfem
             }
 
             // Compute the reverse scatter indices
-            auto rev_idxs_global = std::get<0>(mpi::send_to_dest<int>(fwd_idxs_global, fwd_dest_));
+            auto [rev_idxs_global, rev_counts, rev_displs] = mpi::send_to_dest<int>(fwd_idxs_global, fwd_dest_);
             rev_idxs_ = index_map_->global_to_local(rev_idxs_global);
+
+            // Store the neighbouring processes, i.e. the processes
+            // to which we send and from which we receive values
+            for (int i = 0; i < mpi::n_procs(); i++)
+            {
+                if (counts[i] > 0)
+                {
+                    fwd_procs_.push_back(i);
+                    fwd_counts_.push_back(counts[i]);
+                }
+                if (rev_counts[i] > 0)
+                {
+                    rev_procs_.push_back(i);
+                    rev_counts_.push_back(rev_counts[i]);
+                }
+            }
+        }
+
+        // The persistent requests refer to the scatterer's buffers
+        Scatterer(const Scatterer &) = delete;
+        Scatterer &operator=(const Scatterer &) = delete;
+
+        ~Scatterer()
+        {
+            for (auto &channel : channels_)
+            {
+                mpi::free_all(channel->fwd_requests);
+                mpi::free_all(channel->rev_requests);
+            }
         }
 
         std::shared_ptr<const IndexMap> index_map() const
@@ -63,68 +119,177 @@ namespace sfem
             return rev_idxs_;
         }
 
-        /// @brief Send values for locally owned indices, while receiving values for ghost indices
+        /// @brief Start a forward scatter, i.e. start sending the values for locally owned
+        /// indices and receiving the values for ghost indices
+        /// @note Must be completed with forward_end() before the next scatter is started.
+        /// The locally owned values may be modified in-between, the ghost values may not
         /// @param values Buffer containing values for both locally owned and ghost indices
         /// @param bs Block size
-        /// @param op Binary operation to modify values
-        void forward(std::span<T> values, int bs, std::function<void(T &, T)> op) const
+        void forward_begin(std::span<const T> values, int bs) const
         {
             SFEM_CHECK_SIZES(values.size(), index_map_->n_local() * bs);
+            Channel &ch = channel(bs);
 
-            // Create the send buffer, i.e. store the values for the
-            // forward scatter indices in the correct order
-            std::vector<T> send_buffer(fwd_idxs_.size() * bs);
+            // Pack the values for the forward scatter indices
             for (std::size_t i = 0; i < fwd_idxs_.size(); i++)
             {
-                for (int j = 0; j < bs; j++)
-                {
-                    send_buffer[i * bs + j] = values[fwd_idxs_[i] * bs + j];
-                }
+                std::copy_n(values.data() + fwd_idxs_[i] * bs, bs, ch.fwd_buffer.data() + i * bs);
             }
 
-            // Send the values for the forward scatter indices.
-            // Receive values for ghost indices
-            auto recv_buffer = std::get<0>(mpi::send_to_dest<T>(send_buffer, fwd_dest_, bs));
+            mpi::start_all(ch.fwd_requests);
+        }
+
+        /// @brief Complete a forward scatter started with forward_begin()
+        /// @param values Buffer containing values for both locally owned and ghost indices
+        /// @param bs Block size
+        /// @param op Binary operation to modify values, e.g. InsertOp or AddOp
+        template <typename Op = InsertOp>
+        void forward_end(std::span<T> values, int bs, Op op = {}) const
+        {
+            SFEM_CHECK_SIZES(values.size(), index_map_->n_local() * bs);
+            Channel &ch = channel(bs);
+
+            mpi::wait_all(ch.fwd_requests);
 
             // Modify ghost index values
-            for (std::size_t i = 0; i < rev_idxs_.size(); i++)
-            {
-                for (int j = 0; j < bs; j++)
-                {
-                    op(values[rev_idxs_[i] * bs + j], recv_buffer[i * bs + j]);
-                }
-            }
+            unpack(ch.rev_buffer, rev_idxs_, values, bs, op);
+        }
+
+        /// @brief Send values for locally owned indices, while receiving values for ghost indices
+        /// @param values Buffer containing values for both locally owned and ghost indices
+        /// @param bs Block size
+        /// @param op Binary operation to modify values, e.g. InsertOp or AddOp
+        template <typename Op = InsertOp>
+        void forward(std::span<T> values, int bs, Op op = {}) const
+        {
+            forward_begin(values, bs);
+            forward_end(values, bs, op);
         }
 
         /// @brief Send values for ghosted indices, while receiving values for locally owned indices
         /// @param values Buffer containing values for both locally owned and ghost indices
         /// @param bs Block size
-        /// @param op Binary operation to modify values
-        void reverse(std::span<T> values, int bs, std::function<void(T &, T)> op) const
+        /// @param op Binary operation to modify values, e.g. InsertOp or AddOp
+        template <typename Op = AddOp>
+        void reverse(std::span<T> values, int bs, Op op = {}) const
         {
             SFEM_CHECK_SIZES(values.size(), index_map_->n_local() * bs);
+            Channel &ch = channel(bs);
 
-            // Quick access
-            const int n_owned = index_map_->n_owned();
-
-            // Create the send buffer (ghost index values)
-            std::span<T> send_buffer = {values.begin() + n_owned * bs, values.end()};
+            // Pack the ghost index values, in the order expected by their owners
+            for (std::size_t i = 0; i < rev_idxs_.size(); i++)
+            {
+                std::copy_n(values.data() + rev_idxs_[i] * bs, bs, ch.rev_buffer.data() + i * bs);
+            }
 
-            auto recv_buffer = std::get<0>(mpi::send_to_dest<T>(send_buffer,
-                                                                index_map_->ghost_owners(), bs));
+            mpi::start_all(ch.rev_requests);
+            mpi::wait_all(ch.rev_requests);
 
             // Modify locally owned index values
-            for (std::size_t i = 0; i < fwd_idxs_.size(); i++)
+            unpack(ch.fwd_buffer, fwd_idxs_, values, bs, op);
+        }
+
+    private:
+        /// @brief Combine the values of a packed buffer into the values of the given indices
+        template <typename Op>
+        static void unpack(std::span<const T> buffer,
+                           std::span<const int> idxs,
+                           std::span<T> values,
+                           int bs,
+                           Op op)
+        {
+            if constexpr (std::is_same_v<Op, InsertOp>)
+            {
+                for (std::size_t i = 0; i < idxs.size(); i++)
+                {
+                    std::copy_n(buffer.data() + i * bs, bs, values.data() + idxs[i] * bs);
+                }
+            }
+            else if constexpr (std::is_same_v<Op, AddOp>)
             {
-                for (int j = 0; j < bs; j++)
+                for (std::size_t i = 0; i < idxs.size(); i++)
                 {
+                    const T *src = buffer.data() + i * bs;
+                    T *dest = values.data() + idxs[i] * bs;
+                    for (int j = 0; j < bs; j++)
+                    {
+                        dest[j] += src[j];
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < idxs.size(); i++)
+                {
+                    for (int j = 0; j < bs; j++)
+                    {
+                        op(values[idxs[i] * bs + j], buffer[i * bs + j]);
+                    }
+                }
+            }
+        }
+
+        /// @brief Buffers and persistent requests for a given block size
+        struct Channel
+        {
+            /// @brief Block size
+            int bs;
 
-                    op(values[fwd_idxs_[i] * bs + j], recv_buffer[i * bs + j]);
+            /// @brief Values for the forward and reverse scatter indices, in the order
+            /// in which they are exchanged with the neighbouring processes
+            std::vector<T> fwd_buffer;
+            std::vector<T> rev_buffer;
+
+            /// @brief Persistent requests of the forward scatter (receive into rev_buffer,
+            /// send from fwd_buffer) and the reverse scatter (receive into fwd_buffer,
+            /// send from rev_buffer)
+            std::vector<mpi::Request> fwd_requests;
+            std::vector<mpi::Request> rev_requests;
+        };
+
+        /// @brief Get the channel for a given block size, creating it on first use
+        Channel &channel(int bs) const
+        {
+            for (auto &ch : channels_)
+            {
+                if (ch->bs == bs)
+                {
+                    return *ch;
                 }
             }
+
+            auto &ch = *channels_.emplace_back(std::make_unique<Channel>());
+            ch.bs = bs;
+            ch.fwd_buffer.resize(fwd_idxs_.size() * bs);
+            ch.rev_buffer.resize(rev_idxs_.size() * bs);
+
+            // Receives are listed first, so that they are posted before the sends
+            std::size_t displ = 0;
+            for (std::size_t i = 0; i < rev_procs_.size(); i++)
+            {
+                const auto buffer = std::span(ch.rev_buffer).subspan(displ, rev_counts_[i] * bs);
+                ch.fwd_requests.push_back(mpi::recv_init<T>(buffer, rev_procs_[i]));
+                displ += buffer.size();
+            }
+            displ = 0;
+            for (std::size_t i = 0; i < fwd_procs_.size(); i++)
+            {
+                const auto buffer = std::span(ch.fwd_buffer).subspan(displ, fwd_counts_[i] * bs);
+                ch.fwd_requests.push_back(mpi::send_init<T>(buffer, fwd_procs_[i]));
+                ch.rev_requests.push_back(mpi::recv_init<T>(buffer, fwd_procs_[i]));
+                displ += buffer.size();
+            }
+            displ = 0;
+            for (std::size_t i = 0; i < rev_procs_.size(); i++)
+            {
+                const auto buffer = std::span(ch.rev_buffer).subspan(displ, rev_counts_[i] * bs);
+                ch.rev_requests.push_back(mpi::send_init<T>(buffer, rev_procs_[i]));
+                displ += buffer.size();
+            }
+
+            return ch;
         }
 
-    private:
         /// @brief Index map
         std::shared_ptr<const IndexMap> index_map_;
 
@@ -139,5 +304,18 @@ namespace sfem
         /// @note They are stored in a different order compared
         /// to the index map.
         std::vector<int> rev_idxs_;
+
+        /// @brief Processes to which forward scatter values are sent,
+        /// and number of indices sent to each
+        std::vector<int> fwd_procs_;
+        std::vector<int> fwd_counts_;
+
+        /// @brief Processes from which forward scatter values are received,
+        /// and number of indices received from each
+        std::vector<int> rev_procs_;
+        std::vector<int> rev_counts_;
+
+        /// @brief Channels for the block sizes used so far
+        mutable std::vector<std::unique_ptr<Channel>> channels_;
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
 #include <sfem/parallel/mpi.hpp>
+#include <sfem/parallel/omp.hpp>
 #include <sfem/parallel/index_map.hpp>
 #include <sfem/parallel/scatterer.hpp>
\ No newline at end of file